@@ -1,58 +1,174 @@
 #include "aoc_common_types.h"
+#include "allocation_tracking.h"
+#include "answer_verification.h"
+#include "command_line.h"
 #include "input_retrieval.h"
 #include "puzzle_solvers.h"
+#include "solver_scheduler.h"
+#include "timing.h"
+#include <filesystem>
 #include <iostream>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <vector>
 
-// Based on user input either solve and print the result for a single day, or run through
-// solving and printing the results for all puzzles.
-int main()
+// Timing reports are only written when asked for, into the directory given.
+constexpr const char timingReportJson[] = "solver_timings.json";
+constexpr const char timingReportCsv[] = "solver_timings.csv";
+
+// Work out which days to solve, either from the command line or by asking the user,
+// then solve and print the results for each of them, either one after another or spread
+// across a pool of worker threads.
+int main(int argc, char* argv[])
 {
-	int dayToRun{ 0 };
-	bool runAll{ false };
-	while ((dayToRun <= 0) || (dayToRun > PuzzleSolvers::numberOfPuzzleSolvers))
+	CommandLine::Options options{};
+	if (argc > 1)
+	{
+		if (!CommandLine::ParseArguments(argc, argv, options))
+		{
+			CommandLine::PrintUsage(std::cout);
+			return CommandLine::exitCodeBadArguments;
+		}
+	}
+	else
+	{
+		options = CommandLine::PromptForOptions();
+	}
+
+	// Allocations are only counted on request, since counting them slows down every
+	// allocation the solvers make.
+	if (options.trackAllocations)
+	{
+		AllocationTracking::EnableTracking();
+	}
+
+	if (!options.inputDirectory.empty())
+	{
+		InputRetrieval::SetInputDirectory(options.inputDirectory);
+	}
+	for (auto const& [day, inputFile] : options.inputFileOverrides)
+	{
+		InputRetrieval::SetInputFileForDay(day, inputFile);
+	}
+
+	// Bail out before solving anything if any of the inputs aren't there, rather than
+	// finding out part way through a run.
+	if (!InputRetrieval::CheckPuzzleInputsCanBeOpened(options.days))
+	{
+		return CommandLine::exitCodeMissingInput;
+	}
+	if (options.preloadInputs)
+	{
+		InputRetrieval::PreloadPuzzleInputs(options.days, options.runInParallel);
+	}
+
+	// When verifying, every day has to have answers to check against, so bail out before
+	// solving anything if any of them are missing. Answers given on the command line take
+	// precedence over the recorded ones.
+	if (options.verifyAnswers)
 	{
-		std::cout << "Enter a number between 1 and " << PuzzleSolvers::numberOfPuzzleSolvers <<
-			" to solve that day's puzzle, or \"all\" to solve all days: ";
-		std::string dayAsString;
+		bool anyAnswersMissing{ false };
+		for (unsigned int day : options.days)
+		{
+			if (options.expectedAnswers.count(day) > 0) { continue; }
+
+			std::optional<PuzzleAnswerPair> expectedAnswers = AnswerVerification::FindExpectedAnswers(day);
+			if (expectedAnswers)
+			{
+				options.expectedAnswers[day] = *expectedAnswers;
+			}
+			else
+			{
+				std::cout << "No expected answers recorded for day " << day << "'s input " <<
+					InputRetrieval::GetPathToPuzzleInput(day) << std::endl;
+				anyAnswersMissing = true;
+			}
+		}
+		if (anyAnswersMissing) { return CommandLine::exitCodeMissingExpectedAnswers; }
+	}
+
+	// Every day we solve is timed, and the timings are all gathered up to be reported
+	// once we're done. The answers are only printed the first time round when repeating,
+	// but every repetition is checked against any answers we were told to expect.
+	std::vector<Timing::DayTimings> allTimings{};
+	std::vector<AllocationTracking::DayAllocations> allAllocations{};
+	unsigned int repetition{ 0 };
+	bool anyAnswerMismatched{ false };
+	std::map<unsigned int, PuzzleAnswerPair> answersToRecord{};
+	auto printSolvedDay = [&](SolverScheduler::SolvedDay const& solvedDay)
+	{
+		if (repetition == 0)
+		{
+			std::cout << "Day " << solvedDay.day << ": " <<
+				solvedDay.answerPair.first << ", " << solvedDay.answerPair.second << std::endl;
+		}
+		allTimings.push_back(solvedDay.timings);
+		allAllocations.push_back(AllocationTracking::DayAllocations{ solvedDay.day, solvedDay.allocations });
+		if (options.recordAnswers && (repetition == 0))
+		{
+			answersToRecord[solvedDay.day] = solvedDay.answerPair;
+		}
 
-		std::cin >> dayAsString;
-		if (dayAsString == "all")
+		auto expectedItr = options.expectedAnswers.find(solvedDay.day);
+		if ((expectedItr != options.expectedAnswers.end()) && (expectedItr->second != solvedDay.answerPair))
 		{
-			runAll = true;
-			break;
+			std::cout << "Day " << solvedDay.day << " answers don't match the expected " <<
+				expectedItr->second.first << ", " << expectedItr->second.second << std::endl;
+			anyAnswerMismatched = true;
+		}
+	};
+
+	// When verifying, there's no point carrying on once something has gone wrong.
+	auto stopAfterMismatch = [&]() { return options.verifyAnswers && anyAnswerMismatched; };
+	for (repetition = 0; (repetition < options.repeatCount) && !stopAfterMismatch(); repetition++)
+	{
+		if (options.runInParallel)
+		{
+			// The scheduler hands us back each day's answers in the order we asked for
+			// them, however the work ended up being shared out between the threads.
+			SolverScheduler::SolveDaysInParallel(options.days, options.maxThreads, printSolvedDay);
 		}
 		else
 		{
-			dayToRun = atoi(dayAsString.c_str());
+			// We have an array of puzzle solvers provided to us by the PuzzleSolver namespace,
+			// so this is a simple case of iterating over the chosen days and printing readable
+			// results as we go, with a comma separating the result for part 1 and 2.
+			for (unsigned int day : options.days)
+			{
+				printSolvedDay(SolverScheduler::SolveSingleDay(day));
+				if (stopAfterMismatch()) { break; }
+			}
 		}
 	}
-	std::cout << std::endl;
 
-	if (runAll)
+	// Any answers to record are all written out together, once everything has been solved.
+	if (!answersToRecord.empty())
 	{
-		// We are solving every puzzle. We have an array of puzzle solvers provided to us
-		// by the PuzzleSolver namespace, so this is a simple case of iterating over
-		// that array and printing readable results as we go.
-		unsigned int day = 1;
-		std::ifstream puzzleInput;
-		for (PuzzleFunc puzzleSolver : PuzzleSolvers::puzzleSolvers)
+		AnswerVerification::RecordExpectedAnswers(answersToRecord);
+	}
+
+	// Finish off with a breakdown of where the time went on screen, and if asked for,
+	// written out in machine-readable form for comparing between builds.
+	std::cout << std::endl;
+	Timing::PrintBreakdownTable(std::cout, allTimings);
+	if (!options.timingReportDirectory.empty())
+	{
+		std::filesystem::path reportDirectory{ options.timingReportDirectory };
+		std::ofstream jsonReport{ reportDirectory / timingReportJson };
+		Timing::WriteJsonReport(jsonReport, allTimings);
+		std::ofstream csvReport{ reportDirectory / timingReportCsv };
+		Timing::WriteCsvReport(csvReport, allTimings);
+		if (!jsonReport || !csvReport)
 		{
-			puzzleInput = InputRetrieval::GetInputStreamForPuzzleInput(day);
-			PuzzleAnswerPair answerPair = puzzleSolver(puzzleInput);
-			std::cout << "Day " << day << ": " << answerPair.first << ", " << answerPair.second << std::endl;
-			day++;
+			std::cout << "Couldn't write the timing reports to " << options.timingReportDirectory << std::endl;
 		}
 	}
-	else
+	if (options.trackAllocations)
 	{
-		// Just solve a single day's puzzle and print the result, with a comma separating
-		// the result for part 1 and 2.
-		// And of course, be careful of the fact that day numbering starts from 1, but
-		// our array of puzzle solvers is 0-indexed.
-		std::ifstream puzzleInput = InputRetrieval::GetInputStreamForPuzzleInput(dayToRun);
-		PuzzleAnswerPair answerPair = PuzzleSolvers::puzzleSolvers[dayToRun - 1](puzzleInput);
-		std::cout << "Day " << dayToRun << ": " << answerPair.first << ", " << answerPair.second << std::endl;
+		std::cout << std::endl;
+		AllocationTracking::PrintAllocationTable(std::cout, allAllocations);
 	}
 
-	return 0;
-}
\ No newline at end of file
+	return anyAnswerMismatched ? CommandLine::exitCodeAnswerMismatch : CommandLine::exitCodeSuccess;
+}
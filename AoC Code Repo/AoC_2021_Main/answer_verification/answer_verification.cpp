@@ -0,0 +1,133 @@
+#include "answer_verification.h"
+#include "input_retrieval.h"
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	// Answers are only ever a single line in the file, so any newlines have to be escaped,
+	// along with the tabs that separate the fields.
+	std::string EscapeAnswer(std::string const& answer)
+	{
+		std::string escapedAnswer{};
+		for (char answerChar : answer)
+		{
+			switch (answerChar)
+			{
+			case '\\': escapedAnswer += "\\\\"; break;
+			case '\n': escapedAnswer += "\\n"; break;
+			case '\t': escapedAnswer += "\\t"; break;
+			default: escapedAnswer += answerChar; break;
+			}
+		}
+		return escapedAnswer;
+	}
+
+	std::string UnescapeAnswer(std::string const& escapedAnswer)
+	{
+		std::string answer{};
+		for (unsigned int ii = 0; ii < escapedAnswer.size(); ii++)
+		{
+			if ((escapedAnswer[ii] == '\\') && ((ii + 1) < escapedAnswer.size()))
+			{
+				ii++;
+				switch (escapedAnswer[ii])
+				{
+				case 'n': answer += '\n'; break;
+				case 't': answer += '\t'; break;
+				default: answer += escapedAnswer[ii]; break;
+				}
+			}
+			else
+			{
+				answer += escapedAnswer[ii];
+			}
+		}
+		return answer;
+	}
+
+	std::filesystem::path GetExpectedAnswersFileForInput(std::filesystem::path const& pathToInput)
+	{
+		return pathToInput.parent_path() / AnswerVerification::expectedAnswersFileName;
+	}
+}
+
+// Reads every set of expected answers out of the given file. A missing file just means
+// there aren't any answers recorded yet.
+AnswerVerification::ExpectedAnswers AnswerVerification::ReadExpectedAnswers(std::filesystem::path const& answersFile)
+{
+	ExpectedAnswers expectedAnswers{};
+	std::ifstream answersStream{ answersFile };
+	std::string line;
+	while (std::getline(answersStream, line))
+	{
+		if (!line.empty() && (line.back() == '\r')) { line.pop_back(); }
+		if (line.empty() || (line.front() == '#')) { continue; }
+
+		std::vector<std::string> fields{};
+		std::size_t fieldStart = 0;
+		std::size_t tabPosition;
+		while ((tabPosition = line.find('\t', fieldStart)) != std::string::npos)
+		{
+			fields.push_back(line.substr(fieldStart, tabPosition - fieldStart));
+			fieldStart = tabPosition + 1;
+		}
+		fields.push_back(line.substr(fieldStart));
+
+		if (fields.size() == 3)
+		{
+			expectedAnswers[fields[0]] = PuzzleAnswerPair{ UnescapeAnswer(fields[1]), UnescapeAnswer(fields[2]) };
+		}
+	}
+	return expectedAnswers;
+}
+
+void AnswerVerification::WriteExpectedAnswers(std::filesystem::path const& answersFile, ExpectedAnswers const& expectedAnswers)
+{
+	std::ofstream answersStream{ answersFile };
+	answersStream <<
+		"# Expected answers for the puzzle inputs in this directory, one input per line as:\n"
+		"# <input file name> TAB <part 1 answer> TAB <part 2 answer>\n";
+	for (auto const& [inputFileName, answerPair] : expectedAnswers)
+	{
+		answersStream << inputFileName << '\t' <<
+			EscapeAnswer(answerPair.first) << '\t' <<
+			EscapeAnswer(answerPair.second) << '\n';
+	}
+}
+
+// Input read from standard input has no file name to record answers against, so never
+// has any expected answers, and its answers are never recorded.
+std::optional<PuzzleAnswerPair> AnswerVerification::FindExpectedAnswers(unsigned int day)
+{
+	if (InputRetrieval::IsPuzzleInputFromStandardInput(day)) { return std::nullopt; }
+	std::filesystem::path pathToInput = InputRetrieval::GetPathToPuzzleInput(day);
+	ExpectedAnswers expectedAnswers = ReadExpectedAnswers(GetExpectedAnswersFileForInput(pathToInput));
+
+	auto expectedItr = expectedAnswers.find(pathToInput.filename().string());
+	if (expectedItr == expectedAnswers.end()) { return std::nullopt; }
+	return expectedItr->second;
+}
+
+// The days are first grouped by the answers file their inputs belong to, so that each
+// file only gets rewritten once rather than once per day.
+void AnswerVerification::RecordExpectedAnswers(std::map<unsigned int, PuzzleAnswerPair> const& answersByDay)
+{
+	std::map<std::filesystem::path, ExpectedAnswers> newAnswersByFile{};
+	for (auto const& [day, answerPair] : answersByDay)
+	{
+		if (InputRetrieval::IsPuzzleInputFromStandardInput(day)) { continue; }
+		std::filesystem::path pathToInput = InputRetrieval::GetPathToPuzzleInput(day);
+		newAnswersByFile[GetExpectedAnswersFileForInput(pathToInput)][pathToInput.filename().string()] = answerPair;
+	}
+
+	for (auto const& [answersFile, newAnswers] : newAnswersByFile)
+	{
+		ExpectedAnswers expectedAnswers = ReadExpectedAnswers(answersFile);
+		for (auto const& [inputFileName, answerPair] : newAnswers)
+		{
+			expectedAnswers[inputFileName] = answerPair;
+		}
+		WriteExpectedAnswers(answersFile, expectedAnswers);
+	}
+}
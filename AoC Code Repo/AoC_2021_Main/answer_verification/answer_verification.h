@@ -0,0 +1,33 @@
+#pragma once
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include "aoc_common_types.h"
+
+// Keeps track of the answers each puzzle input is expected to produce, so that a change
+// which breaks a solver gets noticed rather than just making it faster. The expected
+// answers live in a plain text file alongside the inputs they belong to, keyed on the
+// input's file name, so any directory of inputs (e.g. generated ones) can carry its
+// own set of answers. Each line of the file looks like:
+//     <input file name> TAB <part 1 answer> TAB <part 2 answer>
+// with any newlines, tabs or backslashes within an answer written as \n, \t or \\.
+// Blank lines, and lines starting with #, are ignored.
+namespace AnswerVerification
+{
+	constexpr const char expectedAnswersFileName[] = "Expected_Answers.txt";
+
+	using ExpectedAnswers = std::map<std::string, PuzzleAnswerPair>;
+
+	ExpectedAnswers ReadExpectedAnswers(std::filesystem::path const& answersFile);
+	void WriteExpectedAnswers(std::filesystem::path const& answersFile, ExpectedAnswers const& expectedAnswers);
+
+	// Looks up the expected answers for whichever input file the given day will be solved
+	// with, returning nothing if that input doesn't have any recorded.
+	std::optional<PuzzleAnswerPair> FindExpectedAnswers(unsigned int day);
+
+	// Records the answers for whichever input file each given day was solved with as the
+	// expected ones, replacing any that were previously recorded for that input. Each
+	// answers file touched is read and written just once, however many days share it.
+	void RecordExpectedAnswers(std::map<unsigned int, PuzzleAnswerPair> const& answersByDay);
+}
@@ -0,0 +1,268 @@
+#include "command_line.h"
+#include "input_retrieval.h"
+#include "Parsing.h"
+#include "puzzle_solvers.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+	// Parse a string that should consist entirely of a day number, returning false
+	// if it doesn't, or if there's no puzzle for that day.
+	bool ParseDayNumber(std::string const& dayString, unsigned int& day)
+	{
+		Parsing::ConversionResult<unsigned int> dayNumber = Parsing::ConvertNumber<unsigned int>(dayString);
+		if (!dayNumber.Succeeded()) { return false; }
+		day = dayNumber.value;
+		return (day > 0) && (day <= PuzzleSolvers::numberOfPuzzleSolvers);
+	}
+
+	// Parse a string that should consist entirely of a non-negative number.
+	bool ParseCount(std::string const& countString, unsigned int& count)
+	{
+		Parsing::ConversionResult<unsigned int> countNumber = Parsing::ConvertNumber<unsigned int>(countString);
+		if (!countNumber.Succeeded()) { return false; }
+		count = countNumber.value;
+		return true;
+	}
+
+	// Split an argument of the form "DAY=VALUE" into its day and value.
+	bool ParseDayAssignment(std::string const& assignment, unsigned int& day, std::string& value)
+	{
+		std::size_t equalsPosition = assignment.find('=');
+		if (equalsPosition == std::string::npos) { return false; }
+		value = assignment.substr(equalsPosition + 1);
+		return ParseDayNumber(assignment.substr(0, equalsPosition), day);
+	}
+}
+
+// Parse a list of days such as "1,5,19-23" into the individual days it covers, in the
+// order they were given. Returns false if any part of the list isn't a valid day or
+// a valid ascending range of days.
+bool CommandLine::ParseDayList(std::string const& dayList, std::vector<unsigned int>& days)
+{
+	std::size_t startOfEntry = 0;
+	while (startOfEntry <= dayList.size())
+	{
+		std::size_t endOfEntry = dayList.find(',', startOfEntry);
+		if (endOfEntry == std::string::npos) { endOfEntry = dayList.size(); }
+		std::string entry = dayList.substr(startOfEntry, endOfEntry - startOfEntry);
+
+		unsigned int firstDay;
+		unsigned int lastDay;
+		std::size_t dashPosition = entry.find('-');
+		if (dashPosition == std::string::npos)
+		{
+			if (!ParseDayNumber(entry, firstDay)) { return false; }
+			lastDay = firstDay;
+		}
+		else
+		{
+			if (!ParseDayNumber(entry.substr(0, dashPosition), firstDay) ||
+				!ParseDayNumber(entry.substr(dashPosition + 1), lastDay) ||
+				(lastDay < firstDay))
+			{
+				return false;
+			}
+		}
+
+		for (unsigned int day = firstDay; day <= lastDay; day++)
+		{
+			days.push_back(day);
+		}
+		startOfEntry = endOfEntry + 1;
+	}
+	return true;
+}
+
+// Parse the command line arguments into a set of options. If no days are specified,
+// every day is solved. Returns false if the arguments don't make sense, in which
+// case the caller should print the usage and bail out.
+bool CommandLine::ParseArguments(int argc, char* argv[], Options& options)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string argument{ argv[argIndex] };
+		if (argument == "--parallel")
+		{
+			options.runInParallel = true;
+			continue;
+		}
+		if (argument == "--preload")
+		{
+			options.preloadInputs = true;
+			continue;
+		}
+		if (argument == "--verify")
+		{
+			options.verifyAnswers = true;
+			continue;
+		}
+		if (argument == "--record-answers")
+		{
+			options.recordAnswers = true;
+			continue;
+		}
+		if (argument == "--track-allocations")
+		{
+			options.trackAllocations = true;
+			continue;
+		}
+
+		// Every other option takes a value.
+		if ((argIndex + 1) >= argc) { return false; }
+		std::string value{ argv[++argIndex] };
+
+		if (argument == "--days")
+		{
+			if (!ParseDayList(value, options.days)) { return false; }
+		}
+		else if (argument == "--threads")
+		{
+			if (!ParseCount(value, options.maxThreads)) { return false; }
+		}
+		else if (argument == "--repeat")
+		{
+			if (!ParseCount(value, options.repeatCount) || (options.repeatCount == 0)) { return false; }
+		}
+		else if (argument == "--input-dir")
+		{
+			options.inputDirectory = value;
+		}
+		else if (argument == "--timing-report")
+		{
+			options.timingReportDirectory = value;
+		}
+		else if (argument == "--input")
+		{
+			unsigned int day;
+			std::string inputFile;
+			if (!ParseDayAssignment(value, day, inputFile) || inputFile.empty()) { return false; }
+			options.inputFileOverrides[day] = inputFile;
+		}
+		else if (argument == "--expect")
+		{
+			// The expected answers for each part are separated by the first comma, since
+			// neither part's answer is ever expected to contain a comma itself.
+			unsigned int day;
+			std::string answers;
+			if (!ParseDayAssignment(value, day, answers)) { return false; }
+			std::size_t commaPosition = answers.find(',');
+			if (commaPosition == std::string::npos) { return false; }
+			options.expectedAnswers[day] = PuzzleAnswerPair{
+				answers.substr(0, commaPosition), answers.substr(commaPosition + 1) };
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Allocations are counted across every thread, so with several days solved at once the
+	// counts of each day would take in those of the others.
+	if (options.trackAllocations && options.runInParallel)
+	{
+		return false;
+	}
+
+	// Standard input can only be read through once, so only one day can read from it,
+	// and only if it's solved just the once.
+	unsigned int daysFromStandardInput{ 0 };
+	for (auto const& [day, inputFile] : options.inputFileOverrides)
+	{
+		if (inputFile == InputRetrieval::standardInputFileName) { daysFromStandardInput++; }
+	}
+	if ((daysFromStandardInput > 1) || ((daysFromStandardInput == 1) && (options.repeatCount > 1)))
+	{
+		return false;
+	}
+
+	if (options.days.empty())
+	{
+		for (unsigned int day = 1; day <= PuzzleSolvers::numberOfPuzzleSolvers; day++)
+		{
+			options.days.push_back(day);
+		}
+	}
+	return true;
+}
+
+// Based on user input either solve a single day, or all days, either one after another
+// or spread across a pool of worker threads.
+CommandLine::Options CommandLine::PromptForOptions()
+{
+	Options options{};
+	int dayToRun{ 0 };
+	bool runAll{ false };
+	while (!runAll && ((dayToRun <= 0) || (dayToRun > PuzzleSolvers::numberOfPuzzleSolvers)))
+	{
+		std::cout << "Enter a number between 1 and " << PuzzleSolvers::numberOfPuzzleSolvers <<
+			" to solve that day's puzzle, \"all\" to solve all days, or \"parallel\" to solve" <<
+			" all days on multiple threads: ";
+		std::string dayAsString;
+
+		std::cin >> dayAsString;
+		if ((dayAsString == "all") || (dayAsString == "parallel"))
+		{
+			runAll = true;
+			options.runInParallel = (dayAsString == "parallel");
+		}
+		else
+		{
+			dayToRun = std::atoi(dayAsString.c_str());
+		}
+	}
+
+	if (runAll)
+	{
+		for (unsigned int day = 1; day <= PuzzleSolvers::numberOfPuzzleSolvers; day++)
+		{
+			options.days.push_back(day);
+		}
+	}
+	else
+	{
+		options.days.push_back(dayToRun);
+	}
+
+	// When running in parallel, the user can cap the number of worker threads used,
+	// with 0 meaning just use as many as the hardware supports.
+	if (options.runInParallel)
+	{
+		std::cout << "Enter the maximum number of threads to use, or 0 to use all available: ";
+		std::cin >> options.maxThreads;
+	}
+	std::cout << std::endl;
+
+	return options;
+}
+
+void CommandLine::PrintUsage(std::ostream& outputStream)
+{
+	outputStream <<
+		"Usage: AoC_2021_Main [--days LIST] [--parallel] [--threads N] [--input-dir DIR]\n"
+		"                     [--input DAY=FILE] [--preload] [--repeat N] [--expect DAY=PART1,PART2]\n"
+		"                     [--verify] [--record-answers] [--track-allocations]\n"
+		"                     [--timing-report DIR]\n"
+		"  --days LIST             Days to solve, e.g. 1,5,19-23 (default: all days)\n"
+		"  --parallel              Solve the days on a pool of worker threads\n"
+		"  --threads N             Maximum worker threads when parallel (0: all available)\n"
+		"  --input-dir DIR         Directory containing the Puzzle_Input_Day_NN.txt files\n"
+		"  --input DAY=FILE        Use FILE as the input for DAY, or - to read it from standard input\n"
+		"                          (exit code " << exitCodeMissingInput << " if any day's input can't be opened)\n"
+		"  --preload               Load every selected day's input before solving any of them\n"
+		"                          (on multiple threads when solving in parallel)\n"
+		"  --repeat N              Solve the selected days N times over\n"
+		"  --expect DAY=P1,P2      Exit with code " << exitCodeAnswerMismatch <<
+		" if DAY's answers differ from P1,P2\n"
+		"  --verify                Check every day against the answers recorded for its input,\n"
+		"                          stopping at the first mismatch (exit code " << exitCodeAnswerMismatch <<
+		", or " << exitCodeMissingExpectedAnswers << "\n"
+		"                          if an input has no answers recorded)\n"
+		"  --record-answers        Record the answers found as the expected ones for each input\n"
+		"  --track-allocations     Count each day's heap allocations, bytes and peak live bytes\n"
+		"                          (not with --parallel)\n"
+		"  --timing-report DIR     Also write the timings to solver_timings.json and\n"
+		"                          solver_timings.csv in DIR\n" <<
+		"With no arguments, the days to solve are asked for interactively." << std::endl;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "aoc_common_types.h"
+
+// Works out what the user wants the solver to do, either from the command line for
+// headless batch runs, or by prompting on the console when run with no arguments.
+//
+// Usage: AoC_2021_Main [--days LIST] [--parallel] [--threads N] [--input-dir DIR]
+//                      [--input DAY=FILE] [--preload] [--repeat N] [--expect DAY=PART1,PART2]
+//                      [--verify] [--record-answers] [--track-allocations]
+//                      [--timing-report DIR]
+//
+// LIST is a comma separated list of days and ranges of days, e.g. "1,5,19-23".
+// Each of --input and --expect can be given as many times as needed. Giving "-" as the
+// FILE for --input reads that day's input from standard input, which days 1, 2, 3, 6, 7
+// and 10 can solve as it arrives, however big it is.
+// --track-allocations can't be combined with --parallel, since the counts are shared by
+// every thread and so couldn't be told apart from day to day.
+namespace CommandLine
+{
+	// Exit codes for the solver, so that batch jobs can tell what went wrong.
+	constexpr int exitCodeSuccess = 0;
+	constexpr int exitCodeBadArguments = 1;
+	constexpr int exitCodeAnswerMismatch = 2;
+	constexpr int exitCodeMissingExpectedAnswers = 3;
+	constexpr int exitCodeMissingInput = 4;
+
+	struct Options
+	{
+		std::vector<unsigned int> days{};
+		bool runInParallel{ false };
+		unsigned int maxThreads{ 0 };
+		unsigned int repeatCount{ 1 };
+		bool preloadInputs{ false };
+		std::string inputDirectory{};
+		std::map<unsigned int, std::string> inputFileOverrides{};
+		std::map<unsigned int, PuzzleAnswerPair> expectedAnswers{};
+		bool verifyAnswers{ false };
+		bool recordAnswers{ false };
+		bool trackAllocations{ false };
+		std::string timingReportDirectory{};
+	};
+
+	bool ParseDayList(std::string const& dayList, std::vector<unsigned int>& days);
+	bool ParseArguments(int argc, char* argv[], Options& options);
+	Options PromptForOptions();
+	void PrintUsage(std::ostream& outputStream);
+}
@@ -1,14 +1,48 @@
 #include "input_retrieval.h"
 #include <assert.h>
+#include <cstdlib>
 #include <iostream>
 #include <filesystem>
+#include <future>
+#include <map>
 #include <string>
 
-// Returns an input file stream to the file containing the puzzle input for
-// a given day. It is the responsibility of the caller to close the filestream
-// when finished with it.
-std::ifstream InputRetrieval::GetInputStreamForPuzzleInput(unsigned int day)
+namespace
+{
+	std::filesystem::path inputDirectory{ InputRetrieval::relativePathToInputDir };
+	std::map<unsigned int, std::filesystem::path> inputFileOverrides{};
+	std::map<unsigned int, PuzzleInput::MappedFile> preloadedInputs{};
+
+	// Map a day's input and make sure it's been read in from the disk in its entirety.
+	PuzzleInput::MappedFile LoadPuzzleInput(unsigned int day)
+	{
+		PuzzleInput::MappedFile puzzleInput = InputRetrieval::MapPuzzleInput(day);
+		puzzleInput.Prefault();
+		return puzzleInput;
+	}
+}
+
+void InputRetrieval::SetInputDirectory(std::filesystem::path newInputDirectory)
 {
+	inputDirectory = newInputDirectory;
+}
+
+void InputRetrieval::SetInputFileForDay(unsigned int day, std::filesystem::path inputFile)
+{
+	inputFileOverrides[day] = inputFile;
+}
+
+// Returns the path to the file containing the puzzle input for a given day, which
+// will be the standard filename within the input directory unless a specific file
+// has been set for that day.
+std::filesystem::path InputRetrieval::GetPathToPuzzleInput(unsigned int day)
+{
+	auto overrideItr = inputFileOverrides.find(day);
+	if (overrideItr != inputFileOverrides.end())
+	{
+		return overrideItr->second;
+	}
+
 	// All possible day numbers for advent code are either 1 or 2 digits e.g. 6 or 21.
 	// Single digit day numbers are all prepended with a leading 0 to keep them ordered
 	// nicely in the folder, so account for that here.
@@ -18,22 +52,109 @@ std::ifstream InputRetrieval::GetInputStreamForPuzzleInput(unsigned int day)
 
 	// Now that we've constructed the day portion of the filename, we can put the
 	// full path to the input together.
-	std::string fullRelativePathToInput{
-		std::string{relativePathToInputDir} +
-		std::string{puzzleInputFileStem} +
-		dayString +
-		puzzleInputFileExtension
-	};
-	std::ifstream puzzleInputFile{ fullRelativePathToInput.c_str() };
+	return inputDirectory / (std::string{ puzzleInputFileStem } + dayString + puzzleInputFileExtension);
+}
+
+bool InputRetrieval::IsPuzzleInputFromStandardInput(unsigned int day)
+{
+	auto overrideItr = inputFileOverrides.find(day);
+	return (overrideItr != inputFileOverrides.end()) && (overrideItr->second == standardInputFileName);
+}
+
+// Checks that the input for each of the given days can be opened. Days reading from
+// standard input have nothing to open, so they always pass.
+bool InputRetrieval::CheckPuzzleInputsCanBeOpened(std::vector<unsigned int> const& days)
+{
+	bool allInputsCanBeOpened{ true };
+	for (unsigned int day : days)
+	{
+		if (IsPuzzleInputFromStandardInput(day)) { continue; }
+
+		std::filesystem::path pathToInput = GetPathToPuzzleInput(day);
+		if (!std::ifstream{ pathToInput })
+		{
+			std::cerr <<
+				"Failed to find puzzle input file for day " << day << ": " <<
+				std::filesystem::absolute(pathToInput) <<
+				std::endl;
+			allInputsCanBeOpened = false;
+		}
+	}
+	return allInputsCanBeOpened;
+}
+
+// Returns an input file stream to the file containing the puzzle input for
+// a given day. It is the responsibility of the caller to close the filestream
+// when finished with it.
+// The inputs should all have been checked before solving started, so if one can't be
+// opened now there's nothing sensible left to do but stop.
+std::ifstream InputRetrieval::GetInputStreamForPuzzleInput(unsigned int day)
+{
+	std::filesystem::path pathToInput = GetPathToPuzzleInput(day);
+	std::ifstream puzzleInputFile{ pathToInput };
 
 	if (!puzzleInputFile)
 	{
-		std::cout <<
+		std::cerr <<
 			"Failed to find puzzle input file: " <<
-			std::filesystem::absolute(std::filesystem::path(fullRelativePathToInput)) <<
+			std::filesystem::absolute(pathToInput) <<
 			std::endl;
-		assert(false);
+		std::abort();
 	}
 
 	return puzzleInputFile;
 }
+
+// Maps the file containing the puzzle input for a given day into memory. The mapping
+// is released when the returned MappedFile is destroyed.
+// As with the input streams, an input that can't be mapped stops the program.
+PuzzleInput::MappedFile InputRetrieval::MapPuzzleInput(unsigned int day)
+{
+	PuzzleInput::MappedFile puzzleInput{ GetPathToPuzzleInput(day) };
+
+	if (!puzzleInput.IsOpen())
+	{
+		std::cerr <<
+			"Failed to map puzzle input file: " <<
+			std::filesystem::absolute(puzzleInput.Path()) <<
+			std::endl;
+		std::abort();
+	}
+
+	return puzzleInput;
+}
+
+// Load the inputs for each of the given days, keeping them mapped for the rest of the run.
+// When loading in parallel, each file is read in on its own thread, which mostly helps
+// when the inputs aren't already sitting in the OS's file cache.
+void InputRetrieval::PreloadPuzzleInputs(std::vector<unsigned int> const& days, bool loadInParallel)
+{
+	if (loadInParallel)
+	{
+		std::map<unsigned int, std::future<PuzzleInput::MappedFile>> loadingInputs{};
+		for (unsigned int day : days)
+		{
+			if (IsPuzzleInputFromStandardInput(day)) { continue; }
+			loadingInputs[day] = std::async(std::launch::async, LoadPuzzleInput, day);
+		}
+		for (auto& [day, loadingInput] : loadingInputs)
+		{
+			preloadedInputs.insert_or_assign(day, loadingInput.get());
+		}
+	}
+	else
+	{
+		for (unsigned int day : days)
+		{
+			if (IsPuzzleInputFromStandardInput(day)) { continue; }
+			preloadedInputs.insert_or_assign(day, LoadPuzzleInput(day));
+		}
+	}
+}
+
+// Returns the preloaded input for a given day, or nullptr if it wasn't preloaded.
+PuzzleInput::MappedFile const* InputRetrieval::FindPreloadedPuzzleInput(unsigned int day)
+{
+	auto preloadedItr = preloadedInputs.find(day);
+	return (preloadedItr != preloadedInputs.end()) ? &preloadedItr->second : nullptr;
+}
@@ -2,19 +2,50 @@
 #include <fstream>
 #include <filesystem>
 #include <string_view>
+#include <vector>
+#include "puzzle_input.h"
 
 namespace InputRetrieval
 {
 	// Puzzle inputs should be stored within the Puzzle_Inputs directory, with
 	// a consistent filename in which the day number is zero-padded to
 	// a 2-digit length, giving a full path like:
-	// "..\Puzzle_Inputs\Puzzle_Input_Day_04.txt".
-	constexpr const char relativePathToInputDir[] = R"(..\Puzzle_Inputs\)";
+	// "../Puzzle_Inputs/Puzzle_Input_Day_04.txt".
+	constexpr const char relativePathToInputDir[] = R"(../Puzzle_Inputs/)";
 	constexpr const char puzzleInputFileStem[] = R"(Puzzle_Input_Day_)";
 	constexpr const char puzzleInputFileExtension[] = R"(.txt)";
 
+	// A day's input file can be given as "-" to read that day's input from standard input
+	// instead, e.g. when piping in an input too big to keep on disk.
+	constexpr const char standardInputFileName[] = "-";
+
+	// The directory the inputs are read from can be changed, as can the file used
+	// for any individual day. These should be set up before any puzzles are solved,
+	// since they are read without any locking by the solver threads.
+	void SetInputDirectory(std::filesystem::path inputDirectory);
+	void SetInputFileForDay(unsigned int day, std::filesystem::path inputFile);
+	std::filesystem::path GetPathToPuzzleInput(unsigned int day);
+	bool IsPuzzleInputFromStandardInput(unsigned int day);
+
+	// Checks that the input for each of the given days can be opened, printing the path of
+	// any that can't, so that a run can be abandoned before solving anything rather than
+	// part way through.
+	bool CheckPuzzleInputsCanBeOpened(std::vector<unsigned int> const& days);
+
 	// Returns an input file stream to the file containing the puzzle input for
 	// a given day. It is the responsibility of the caller to close the filestream
-	// when finished with it.
+	// when finished with it. The program stops if the file can't be opened.
 	std::ifstream GetInputStreamForPuzzleInput(unsigned int day);
+
+	// Maps the file containing the puzzle input for a given day into memory. The mapping
+	// is released when the returned MappedFile is destroyed. The program stops if the file
+	// can't be mapped.
+	PuzzleInput::MappedFile MapPuzzleInput(unsigned int day);
+
+	// Puzzle inputs can be loaded up front and kept for the rest of the run, so that solving
+	// the same days over and over doesn't go back to the disk each time. As with the input
+	// paths, preloading should be done before any puzzles are solved. Days reading from
+	// standard input can't be preloaded, and are skipped.
+	void PreloadPuzzleInputs(std::vector<unsigned int> const& days, bool loadInParallel);
+	PuzzleInput::MappedFile const* FindPreloadedPuzzleInput(unsigned int day);
 }
\ No newline at end of file
@@ -3,50 +3,157 @@
 #include <fstream>
 #include <utility>
 #include "aoc_common_types.h"
+#include "puzzle_input.h"
 
 // Provides the means to access the puzzle solver functions for each day.
 // An array of puzzle solvers allows for iteration over all days, or access
 // to a specific day's solver.
 namespace PuzzleSolvers
 {
-	PuzzleAnswerPair AocDayOneSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayTwoSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayThreeSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayFourSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayFiveSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDaySixSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDaySevenSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayEightSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayNineSolver(std::ifstream &puzzleInputFile);
-	PuzzleAnswerPair AocDayTenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayElevenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwelveSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayThirteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayFourteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayFifteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDaySixteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDaySeventeenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayEighteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayNineteenSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentySolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentyOneSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentyTwoSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentyThreeSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentyFourSolver(std::ifstream& puzzleInputFile);
-	PuzzleAnswerPair AocDayTwentyFiveSolver(std::ifstream& puzzleInputFile);
+	// Some days' solvers are streaming solvers, which are pushed their input one token at a
+	// time as it's read rather than reading the whole lot in up front. These only need as
+	// much memory as the puzzle itself does, so can be fed inputs far bigger than memory,
+	// e.g. from a pipe. A streaming solver is a class with:
+	//  - a static recordDelimiters, the characters which separate one record from the next
+	//    (e.g. PuzzleInput::lineEndings for a record per line)
+	//  - ConsumeRecord(std::string_view), called for each non-empty record in turn
+	//  - Answers(), called once there's no input left
+	// Each streaming day has a solver for mapped input and one for streamed input, both
+	// made from the same class by these templates.
+	// Where the answers don't depend on the order the records arrive in, a solver can also
+	// have Merge(StreamingSolver&&), which takes in everything another solver has consumed.
+	// Mapped input for these solvers is then split between threads, with a solver per
+	// chunk, and the solvers merged together in order at the end.
+	template <typename StreamingSolver>
+	concept MergeableStreamingSolver = requires(StreamingSolver solver, StreamingSolver otherSolver)
+	{
+		solver.Merge(std::move(otherSolver));
+	};
+
+	template <typename StreamingSolver>
+	PuzzleAnswerPair SolveMappedInput(PuzzleInput::MappedFile const& puzzleInput)
+	{
+		auto consumeRecords = [](std::string_view text)
+		{
+			StreamingSolver solver{};
+			for (std::string_view record : PuzzleInput::Tokens(text, StreamingSolver::recordDelimiters))
+			{
+				solver.ConsumeRecord(record);
+			}
+			return solver;
+		};
+
+		if constexpr (MergeableStreamingSolver<StreamingSolver>)
+		{
+			std::vector<StreamingSolver> chunkSolvers = PuzzleInput::ForEachChunkInParallel(
+				puzzleInput.Contents(), StreamingSolver::recordDelimiters, consumeRecords);
+			for (std::size_t ii = 1; ii < chunkSolvers.size(); ii++)
+			{
+				chunkSolvers[0].Merge(std::move(chunkSolvers[ii]));
+			}
+			return chunkSolvers[0].Answers();
+		}
+		else
+		{
+			return consumeRecords(puzzleInput.Contents()).Answers();
+		}
+	}
+	template <typename StreamingSolver>
+	PuzzleAnswerPair SolveInputStream(std::istream& puzzleInputStream)
+	{
+		StreamingSolver solver{};
+		PuzzleInput::ForEachToken(puzzleInputStream, StreamingSolver::recordDelimiters,
+			[&solver](std::string_view record) { solver.ConsumeRecord(record); });
+		return solver.Answers();
+	}
+
+	PuzzleAnswerPair AocDayOneSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDayOneStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDayTwoSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDayTwoStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDayThreeSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDayThreeStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDayFourSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayFiveSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDaySixSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDaySixStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDaySevenSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDaySevenStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDayEightSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayNineSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTenSolver(PuzzleInput::MappedFile const& puzzleInput);
+	PuzzleAnswerPair AocDayTenStreamingSolver(std::istream& puzzleInputStream);
+	PuzzleAnswerPair AocDayElevenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwelveSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayThirteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayFourteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayFifteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDaySixteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDaySeventeenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayEighteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayNineteenSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentySolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentyOneSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentyTwoSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentyThreeSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentyFourSolver(std::istream& puzzleInputFile);
+	PuzzleAnswerPair AocDayTwentyFiveSolver(std::istream& puzzleInputFile);
+
+	// Wraps up a solver which still reads its input through a stream so that it can be
+	// called like one that reads from the mapped input. The stream reads straight out of
+	// the mapping, so the file isn't read again, but these solvers still pay for stream
+	// extraction until they're moved over to the new signature.
+	template <PuzzleFunc streamSolver>
+	PuzzleAnswerPair StreamSolverAdapter(PuzzleInput::MappedFile const& puzzleInput)
+	{
+		PuzzleInput::ViewStreamBuffer inputBuffer{ puzzleInput.Contents() };
+		std::istream puzzleInputStream{ &inputBuffer };
+		return streamSolver(puzzleInputStream);
+	}
 
 	constexpr unsigned int numberOfPuzzleSolvers = 25;
-	constexpr PuzzleFunc puzzleSolvers[numberOfPuzzleSolvers] = { 
+	constexpr PuzzleInputFunc puzzleSolvers[numberOfPuzzleSolvers] = {
 		AocDayOneSolver,
 		AocDayTwoSolver,
 		AocDayThreeSolver,
-		AocDayFourSolver,
-		AocDayFiveSolver,
+		StreamSolverAdapter<AocDayFourSolver>,
+		StreamSolverAdapter<AocDayFiveSolver>,
 		AocDaySixSolver,
 		AocDaySevenSolver,
+		StreamSolverAdapter<AocDayEightSolver>,
+		StreamSolverAdapter<AocDayNineSolver>,
+		AocDayTenSolver,
+		StreamSolverAdapter<AocDayElevenSolver>,
+		StreamSolverAdapter<AocDayTwelveSolver>,
+		StreamSolverAdapter<AocDayThirteenSolver>,
+		StreamSolverAdapter<AocDayFourteenSolver>,
+		StreamSolverAdapter<AocDayFifteenSolver>,
+		StreamSolverAdapter<AocDaySixteenSolver>,
+		StreamSolverAdapter<AocDaySeventeenSolver>,
+		StreamSolverAdapter<AocDayEighteenSolver>,
+		StreamSolverAdapter<AocDayNineteenSolver>,
+		StreamSolverAdapter<AocDayTwentySolver>,
+		StreamSolverAdapter<AocDayTwentyOneSolver>,
+		StreamSolverAdapter<AocDayTwentyTwoSolver>,
+		StreamSolverAdapter<AocDayTwentyThreeSolver>,
+		StreamSolverAdapter<AocDayTwentyFourSolver>,
+		StreamSolverAdapter<AocDayTwentyFiveSolver>
+	};
+
+	// Solvers for input which can only be read as a stream, e.g. from standard input. The
+	// streaming days read it a chunk at a time, while every other day just reads the stream
+	// in full as it always has.
+	constexpr PuzzleFunc inputStreamSolvers[numberOfPuzzleSolvers] = {
+		AocDayOneStreamingSolver,
+		AocDayTwoStreamingSolver,
+		AocDayThreeStreamingSolver,
+		AocDayFourSolver,
+		AocDayFiveSolver,
+		AocDaySixStreamingSolver,
+		AocDaySevenStreamingSolver,
 		AocDayEightSolver,
 		AocDayNineSolver,
-		AocDayTenSolver,
+		AocDayTenStreamingSolver,
 		AocDayElevenSolver,
 		AocDayTwelveSolver,
 		AocDayThirteenSolver,
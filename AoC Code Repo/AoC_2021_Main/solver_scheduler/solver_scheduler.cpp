@@ -0,0 +1,164 @@
+#include "solver_scheduler.h"
+#include "input_retrieval.h"
+#include "puzzle_solvers.h"
+#include <cassert>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <thread>
+
+// Solve a single day's puzzle, timing how long it takes to map the input file and
+// how long the solver takes to run, and collecting any phases the solver reports.
+// The allocation counts cover every thread, so they include anything the solver hands
+// out to worker threads. They'd also include other days being solved alongside it, which
+// is why allocations can't be tracked when solving in parallel.
+// If the day's input has been preloaded, that's used instead of mapping it afresh, and
+// if it's coming from standard input then it's handed to the solver as a stream.
+SolverScheduler::SolvedDay SolverScheduler::SolveSingleDay(unsigned int day)
+{
+	assert((day > 0) && (day <= PuzzleSolvers::numberOfPuzzleSolvers));
+	SolvedDay solvedDay{};
+	solvedDay.day = day;
+	solvedDay.timings.day = day;
+
+	// Day numbering starts from 1, but our arrays of puzzle solvers are 0-indexed.
+	auto runSolver = [&solvedDay](auto solve)
+	{
+		Timing::BeginPhaseRecording();
+		AllocationTracking::ResetPeakLiveBytes();
+		AllocationTracking::AllocationStats allocationsBefore = AllocationTracking::CurrentStats();
+		Timing::Clock::time_point startTime = Timing::Clock::now();
+		solvedDay.answerPair = solve();
+		solvedDay.timings.solveMilliseconds = Timing::MillisecondsSince(startTime);
+		solvedDay.allocations = AllocationTracking::CurrentStats() - allocationsBefore;
+		solvedDay.timings.phases = Timing::EndPhaseRecording();
+	};
+
+	// There's nothing to open for standard input, reading it is part of solving the puzzle.
+	if (InputRetrieval::IsPuzzleInputFromStandardInput(day))
+	{
+		runSolver([day]() { return PuzzleSolvers::inputStreamSolvers[day - 1](std::cin); });
+		return solvedDay;
+	}
+
+	Timing::Clock::time_point startTime = Timing::Clock::now();
+	PuzzleInput::MappedFile const* preloadedInput = InputRetrieval::FindPreloadedPuzzleInput(day);
+	std::optional<PuzzleInput::MappedFile> mappedInput{};
+	if (preloadedInput == nullptr)
+	{
+		mappedInput.emplace(InputRetrieval::MapPuzzleInput(day));
+	}
+	PuzzleInput::MappedFile const& puzzleInput = (preloadedInput != nullptr) ? *preloadedInput : *mappedInput;
+	solvedDay.timings.inputOpenMilliseconds = Timing::MillisecondsSince(startTime);
+
+	runSolver([day, &puzzleInput]() { return PuzzleSolvers::puzzleSolvers[day - 1](puzzleInput); });
+	return solvedDay;
+}
+
+// Days are queued up at the back, and the owner of the queue takes them from the front.
+void SolverScheduler::WorkStealingQueue::Push(unsigned int day)
+{
+	std::lock_guard<std::mutex> lock{ queueMutex };
+	daysToSolve.push_back(day);
+}
+bool SolverScheduler::WorkStealingQueue::TryPop(unsigned int& day)
+{
+	std::lock_guard<std::mutex> lock{ queueMutex };
+	if (daysToSolve.empty()) { return false; }
+	day = daysToSolve.front();
+	daysToSolve.pop_front();
+	return true;
+}
+
+// Other workers steal from the back of the queue, i.e. the day the owner would
+// otherwise have got to last.
+bool SolverScheduler::WorkStealingQueue::TrySteal(unsigned int& day)
+{
+	std::lock_guard<std::mutex> lock{ queueMutex };
+	if (daysToSolve.empty()) { return false; }
+	day = daysToSolve.back();
+	daysToSolve.pop_back();
+	return true;
+}
+
+// Solve each of the given days on a pool of worker threads, reporting the results
+// back via the callback in the order the days were requested.
+// The days are dealt out round-robin between the workers' queues up front. Each worker
+// then works through its own queue, and once that's empty it goes round the other
+// workers' queues stealing days until there is nothing left to steal. No new days are
+// ever added once the workers have started, so a worker that finds every queue empty
+// can safely finish.
+void SolverScheduler::SolveDaysInParallel(
+	std::vector<unsigned int> const& days,
+	unsigned int maxThreads,
+	DaySolvedCallback onDaySolved)
+{
+	if (days.empty()) { return; }
+
+	unsigned int numberOfWorkers = (maxThreads == 0) ? std::thread::hardware_concurrency() : maxThreads;
+	if (numberOfWorkers == 0) { numberOfWorkers = 1; }
+	if (numberOfWorkers > days.size()) { numberOfWorkers = static_cast<unsigned int>(days.size()); }
+
+	// The queues hold a mutex, so can't live directly in a resizable vector.
+	// Workers only deal in positions within the list of days requested, which lets us
+	// match results back up with the order the caller asked for them in.
+	std::vector<std::unique_ptr<WorkStealingQueue>> workQueues{};
+	for (unsigned int worker = 0; worker < numberOfWorkers; worker++)
+	{
+		workQueues.push_back(std::make_unique<WorkStealingQueue>());
+	}
+	for (unsigned int position = 0; position < days.size(); position++)
+	{
+		workQueues[position % numberOfWorkers]->Push(position);
+	}
+
+	std::vector<std::optional<SolvedDay>> results(days.size());
+	std::mutex resultsMutex;
+	std::condition_variable resultReady;
+
+	auto workerLoop = [&](unsigned int workerIndex)
+	{
+		unsigned int position;
+		while (true)
+		{
+			bool foundWork = workQueues[workerIndex]->TryPop(position);
+			for (unsigned int offset = 1; !foundWork && (offset < numberOfWorkers); offset++)
+			{
+				foundWork = workQueues[(workerIndex + offset) % numberOfWorkers]->TrySteal(position);
+			}
+			if (!foundWork) { break; }
+
+			SolvedDay solvedDay = SolveSingleDay(days[position]);
+			{
+				std::lock_guard<std::mutex> lock{ resultsMutex };
+				results[position] = std::move(solvedDay);
+			}
+			resultReady.notify_one();
+		}
+	};
+
+	std::vector<std::thread> workers{};
+	for (unsigned int worker = 0; worker < numberOfWorkers; worker++)
+	{
+		workers.emplace_back(workerLoop, worker);
+	}
+
+	// While the workers get on with it, report each result as soon as it and everything
+	// requested before it is available, so that the caller sees the days in order.
+	for (unsigned int position = 0; position < days.size(); position++)
+	{
+		SolvedDay solvedDay;
+		{
+			std::unique_lock<std::mutex> lock{ resultsMutex };
+			resultReady.wait(lock, [&] { return results[position].has_value(); });
+			solvedDay = *results[position];
+		}
+		onDaySolved(solvedDay);
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
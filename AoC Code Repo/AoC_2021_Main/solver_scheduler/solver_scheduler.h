@@ -0,0 +1,59 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "aoc_common_types.h"
+#include "allocation_tracking.h"
+#include "timing.h"
+
+// Provides the means to solve a collection of days' puzzles on a pool of worker threads,
+// rather than one after another on the main thread. Some days take far longer to solve
+// than others, so rather than just carving up the days between threads ahead of time,
+// each worker has its own queue of days to solve and will steal work from the other
+// workers' queues once its own runs dry. That way no thread sits idle while there
+// are still puzzles waiting to be solved.
+namespace SolverScheduler
+{
+	// The answers to a single day's puzzle, along with how long it took to get them and
+	// how much heap memory the solver used (only counted if allocation tracking is on).
+	struct SolvedDay
+	{
+		unsigned int day{ 0 };
+		PuzzleAnswerPair answerPair{};
+		Timing::DayTimings timings{};
+		AllocationTracking::AllocationStats allocations{};
+	};
+
+	// Open the input for a single day and solve that day's puzzle on the calling thread,
+	// timing both the file open and the solver itself, and counting the solver's allocations.
+	SolvedDay SolveSingleDay(unsigned int day);
+
+	// Called once for each day that has been solved, always in the order in which the
+	// days were requested, regardless of which order the worker threads finished them in.
+	using DaySolvedCallback = std::function<void(SolvedDay const& solvedDay)>;
+
+	// A queue of days waiting to be solved, owned by a single worker thread. The owning
+	// worker takes days from the front of its queue, while any other worker looking for
+	// work steals from the back, so the owner and any thieves work inwards from opposite
+	// ends of the queue.
+	class WorkStealingQueue
+	{
+	private:
+		std::deque<unsigned int> daysToSolve{};
+		std::mutex queueMutex;
+	public:
+		void Push(unsigned int day);
+		bool TryPop(unsigned int& day);
+		bool TrySteal(unsigned int& day);
+	};
+
+	// Solve each of the given days on a pool of up to maxThreads worker threads (or as
+	// many threads as the hardware supports, if maxThreads is 0). The callback will be
+	// invoked on the calling thread for each day in turn, as soon as that day and every
+	// day before it in the list have been solved.
+	void SolveDaysInParallel(
+		std::vector<unsigned int> const& days,
+		unsigned int maxThreads,
+		DaySolvedCallback onDaySolved);
+}
@@ -0,0 +1,428 @@
+#include "aoc_common_types.h"
+#include "allocation_tracking.h"
+#include "answer_verification.h"
+#include "command_line.h"
+#include "input_retrieval.h"
+#include "Parsing.h"
+#include "puzzle_solvers.h"
+#include "timing.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// A separate executable for benchmarking the puzzle solvers, so that we can judge whether
+// a change actually made things faster. Each solver is run a number of times to warm up
+// (caches, branch predictors, the allocator) and then a number of timed runs, from which
+// we report the spread of latencies, how many heap allocations each run made, and the
+// most heap memory any run had in use at once.
+//
+// Usage: AoC_Benchmark [--iterations N] [--warmup N] [--pin CPU] [--verify] [--parsing] [day...]
+// If no days are given, every day is benchmarked. With --verify, the answers from every
+// run are also checked against those recorded for each input, so that an optimisation
+// can be timed and checked for correctness in one go.
+// With --parsing, the solvers aren't run at all, and instead the regex based line parser
+// is compared with the format string and record schema ones on the lines of a few days'
+// inputs.
+
+namespace
+{
+	struct BenchmarkSettings
+	{
+		unsigned int iterations{ 20 };
+		unsigned int warmupIterations{ 3 };
+		int pinnedCpu{ -1 };
+		bool verifyAnswers{ false };
+		bool benchmarkParsing{ false };
+		std::vector<unsigned int> days{};
+	};
+
+	struct BenchmarkResult
+	{
+		unsigned int day{ 0 };
+		double minMilliseconds{ 0 };
+		double medianMilliseconds{ 0 };
+		double p99Milliseconds{ 0 };
+		double allocationsPerRun{ 0 };
+		double bytesPerRun{ 0 };
+		LLINT peakLiveBytes{ 0 };
+		bool allAnswersMatched{ true };
+	};
+
+	// Run a single day's solver once, returning how long it took and how many allocations
+	// it made. Every input is preloaded before benchmarking starts, since we're only
+	// interested in the solver itself.
+	double TimeSingleRun(
+		unsigned int day,
+		AllocationTracking::AllocationStats& allocationsDuringRun,
+		PuzzleAnswerPair& answerPair)
+	{
+		PuzzleInput::MappedFile const& puzzleInput = *InputRetrieval::FindPreloadedPuzzleInput(day);
+		AllocationTracking::ResetPeakLiveBytes();
+		AllocationTracking::AllocationStats statsBefore = AllocationTracking::CurrentStats();
+		Timing::Clock::time_point startTime = Timing::Clock::now();
+		answerPair = PuzzleSolvers::puzzleSolvers[day - 1](puzzleInput);
+		double runTime = Timing::MillisecondsSince(startTime);
+		allocationsDuringRun = AllocationTracking::CurrentStats() - statsBefore;
+		return runTime;
+	}
+
+	// Any expected answers are checked after every timed run, outside of the measured region.
+	BenchmarkResult BenchmarkDay(
+		unsigned int day,
+		BenchmarkSettings const& settings,
+		PuzzleAnswerPair const* expectedAnswers)
+	{
+		AllocationTracking::AllocationStats allocationsDuringRun{};
+		PuzzleAnswerPair answerPair{};
+		for (unsigned int ii = 0; ii < settings.warmupIterations; ii++)
+		{
+			TimeSingleRun(day, allocationsDuringRun, answerPair);
+		}
+
+		std::vector<double> runTimes{};
+		AllocationTracking::AllocationStats totalAllocations{};
+		bool allAnswersMatched{ true };
+		for (unsigned int ii = 0; ii < settings.iterations; ii++)
+		{
+			runTimes.push_back(TimeSingleRun(day, allocationsDuringRun, answerPair));
+			totalAllocations.allocations += allocationsDuringRun.allocations;
+			totalAllocations.bytesAllocated += allocationsDuringRun.bytesAllocated;
+			totalAllocations.peakLiveBytes = std::max(totalAllocations.peakLiveBytes, allocationsDuringRun.peakLiveBytes);
+			if ((expectedAnswers != nullptr) && (answerPair != *expectedAnswers))
+			{
+				allAnswersMatched = false;
+			}
+		}
+
+		// The p99 is the smallest run time that at least 99% of runs were no slower than.
+		std::sort(runTimes.begin(), runTimes.end());
+		unsigned int p99Index = static_cast<unsigned int>((runTimes.size() * 99 + 99) / 100) - 1;
+
+		BenchmarkResult result{};
+		result.day = day;
+		result.minMilliseconds = runTimes.front();
+		result.medianMilliseconds = runTimes[runTimes.size() / 2];
+		result.p99Milliseconds = runTimes[p99Index];
+		result.allocationsPerRun = static_cast<double>(totalAllocations.allocations) / settings.iterations;
+		result.bytesPerRun = static_cast<double>(totalAllocations.bytesAllocated) / settings.iterations;
+		result.peakLiveBytes = totalAllocations.peakLiveBytes;
+		result.allAnswersMatched = allAnswersMatched;
+		return result;
+	}
+
+	// Time a line parser making one pass over every line of a day's input, in the same way
+	// as a solver is timed. Each parser adds up the values it parsed, both so that the work
+	// can't be optimised away and so that the parsers can be checked against each other.
+	template <typename LineParser>
+	LLINT BenchmarkLineParser(
+		char const* parserName,
+		std::vector<std::string> const& inputLines,
+		BenchmarkSettings const& settings,
+		LineParser parseLine)
+	{
+		std::vector<double> runTimes{};
+		AllocationTracking::AllocationStats allocationsDuringRun{};
+		LLINT totalOfValues{ 0 };
+		for (unsigned int ii = 0; ii < (settings.warmupIterations + settings.iterations); ii++)
+		{
+			AllocationTracking::AllocationStats statsBefore = AllocationTracking::CurrentStats();
+			Timing::Clock::time_point startTime = Timing::Clock::now();
+			totalOfValues = 0;
+			for (std::string const& inputLine : inputLines)
+			{
+				totalOfValues += parseLine(inputLine);
+			}
+			double runTime = Timing::MillisecondsSince(startTime);
+			allocationsDuringRun = AllocationTracking::CurrentStats() - statsBefore;
+			if (ii >= settings.warmupIterations) { runTimes.push_back(runTime); }
+		}
+
+		std::sort(runTimes.begin(), runTimes.end());
+		std::cout << std::setprecision(3) <<
+			std::setw(10) << parserName << " | " <<
+			std::setw(10) << runTimes.front() << " | " <<
+			std::setw(11) << runTimes[runTimes.size() / 2] << " | " <<
+			std::setprecision(0) <<
+			std::setw(10) << allocationsDuringRun.allocations << std::endl;
+		return totalOfValues;
+	}
+
+	// Compare the regex based ParseStringIntoElements with ParseFormattedString on the
+	// lines of days 5, 17 and 22. Returns false if they didn't parse the same values.
+	bool BenchmarkLineParsers(BenchmarkSettings const& settings)
+	{
+		auto readInputLines = [](unsigned int day)
+		{
+			std::vector<std::string> inputLines{};
+			PuzzleInput::MappedFile puzzleInput = InputRetrieval::MapPuzzleInput(day);
+			for (std::string_view inputLine : PuzzleInput::Lines(puzzleInput.Contents()))
+			{
+				inputLines.emplace_back(inputLine);
+			}
+			return inputLines;
+		};
+
+		bool allParsersAgreed{ true };
+		auto compareParsers = [&](unsigned int day, auto regexParser, auto formatParser, auto recordParser)
+		{
+			std::vector<std::string> inputLines = readInputLines(day);
+			std::cout << "Day " << day << " (" << inputLines.size() << " lines)" << std::endl;
+			std::cout << "    Parser |   Min (ms) | Median (ms) | Allocs/run" << std::endl;
+			std::cout << "-----------+------------+-------------+-----------" << std::endl;
+			LLINT regexTotal = BenchmarkLineParser("regex", inputLines, settings, regexParser);
+			LLINT formatTotal = BenchmarkLineParser("format", inputLines, settings, formatParser);
+			LLINT recordTotal = BenchmarkLineParser("record", inputLines, settings, recordParser);
+			if ((regexTotal != formatTotal) || (regexTotal != recordTotal))
+			{
+				std::cout << "Parsers disagree for day " << day << ": " <<
+					regexTotal << " vs " << formatTotal << " vs " << recordTotal << std::endl;
+				allParsersAgreed = false;
+			}
+			std::cout << std::endl;
+		};
+
+		std::regex dayFivePattern{ "([0-9]+),([0-9]+) -> ([0-9]+),([0-9]+)" };
+		compareParsers(5,
+			[&](std::string const& inputLine)
+			{
+				int x1, y1, x2, y2;
+				Parsing::ParseStringIntoElements(inputLine, dayFivePattern, x1, y1, x2, y2);
+				return static_cast<LLINT>(x1 + y1 + x2 + y2);
+			},
+			[](std::string const& inputLine)
+			{
+				int x1, y1, x2, y2;
+				if (!Parsing::ParseFormattedString<"{},{} -> {},{}">(inputLine, x1, y1, x2, y2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(x1 + y1 + x2 + y2);
+			},
+			[](std::string const& inputLine)
+			{
+				using LineRecord = Parsing::Record<
+					Parsing::Int, Parsing::Sep<','>, Parsing::Int,
+					Parsing::Lit<" -> ">,
+					Parsing::Int, Parsing::Sep<','>, Parsing::Int>;
+				int x1, y1, x2, y2;
+				if (!LineRecord::Parse(inputLine, x1, y1, x2, y2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(x1 + y1 + x2 + y2);
+			});
+
+		std::regex daySeventeenPattern{ "target area: x=([0-9]+)..([0-9]+), y=(-[0-9]+)..(-[0-9]+)" };
+		compareParsers(17,
+			[&](std::string const& inputLine)
+			{
+				int x1, x2, y1, y2;
+				Parsing::ParseStringIntoElements(inputLine, daySeventeenPattern, x1, x2, y1, y2);
+				return static_cast<LLINT>(x1 + x2 + y1 + y2);
+			},
+			[](std::string const& inputLine)
+			{
+				int x1, x2, y1, y2;
+				if (!Parsing::ParseFormattedString<"target area: x={}..{}, y={}..{}">(inputLine, x1, x2, y1, y2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(x1 + x2 + y1 + y2);
+			},
+			[](std::string const& inputLine)
+			{
+				using TargetAreaRecord = Parsing::Record<
+					Parsing::Lit<"target area: x=">, Parsing::Int, Parsing::Lit<"..">, Parsing::Int,
+					Parsing::Lit<", y=">, Parsing::Int, Parsing::Lit<"..">, Parsing::Int>;
+				int x1, x2, y1, y2;
+				if (!TargetAreaRecord::Parse(inputLine, x1, x2, y1, y2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(x1 + x2 + y1 + y2);
+			});
+
+		std::regex dayTwentyTwoPattern{
+			"^([a-z]+) x=(-{0,1}[0-9]+)..(-{0,1}[0-9]+),y=(-{0,1}[0-9]+)..(-{0,1}[0-9]+),z=(-{0,1}[0-9]+)..(-{0,1}[0-9]+)$" };
+		compareParsers(22,
+			[&](std::string const& inputLine)
+			{
+				std::string onOrOff;
+				int x1, x2, y1, y2, z1, z2;
+				Parsing::ParseStringIntoElements(inputLine, dayTwentyTwoPattern, onOrOff, x1, x2, y1, y2, z1, z2);
+				return static_cast<LLINT>(onOrOff.size() + x1 + x2 + y1 + y2 + z1 + z2);
+			},
+			[](std::string const& inputLine)
+			{
+				std::string_view onOrOff;
+				int x1, x2, y1, y2, z1, z2;
+				if (!Parsing::ParseFormattedString<"{} x={}..{},y={}..{},z={}..{}">(inputLine, onOrOff, x1, x2, y1, y2, z1, z2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(onOrOff.size() + x1 + x2 + y1 + y2 + z1 + z2);
+			},
+			[](std::string const& inputLine)
+			{
+				using RebootStepRecord = Parsing::Record<
+					Parsing::Word, Parsing::Lit<" x=">, Parsing::Int, Parsing::Lit<"..">, Parsing::Int,
+					Parsing::Lit<",y=">, Parsing::Int, Parsing::Lit<"..">, Parsing::Int,
+					Parsing::Lit<",z=">, Parsing::Int, Parsing::Lit<"..">, Parsing::Int>;
+				std::string_view onOrOff;
+				int x1, x2, y1, y2, z1, z2;
+				if (!RebootStepRecord::Parse(inputLine, onOrOff, x1, x2, y1, y2, z1, z2)) { return LLINT{ -1 }; }
+				return static_cast<LLINT>(onOrOff.size() + x1 + x2 + y1 + y2 + z1 + z2);
+			});
+
+		return allParsersAgreed;
+	}
+
+	// Pin the calling thread to a single CPU, to stop the scheduler moving us between
+	// cores mid-benchmark. Returns false if the OS refused.
+	bool PinToCpu(unsigned int cpu)
+	{
+#ifdef _WIN32
+		return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+		return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+	}
+
+	// Parse a count, CPU number or day given on the command line. Anything that isn't
+	// entirely a non-negative number, or is below the smallest value that makes sense for
+	// the setting, is rejected.
+	bool ParseSetting(std::string const& settingString, unsigned int minimumValue, unsigned int& setting)
+	{
+		Parsing::ConversionResult<unsigned int> settingNumber = Parsing::ConvertNumber<unsigned int>(settingString);
+		if (!settingNumber.Succeeded() || (settingNumber.value < minimumValue)) { return false; }
+		setting = settingNumber.value;
+		return true;
+	}
+
+	// Parse the command line into the benchmark settings. Returns false if the command
+	// line doesn't make sense, in which case usage should be printed.
+	bool ParseArguments(int argc, char* argv[], BenchmarkSettings& settings)
+	{
+		for (int argIndex = 1; argIndex < argc; argIndex++)
+		{
+			std::string argument{ argv[argIndex] };
+			bool hasValue = (argIndex + 1) < argc;
+			if ((argument == "--iterations") && hasValue)
+			{
+				if (!ParseSetting(argv[++argIndex], 1, settings.iterations)) { return false; }
+			}
+			else if ((argument == "--warmup") && hasValue)
+			{
+				if (!ParseSetting(argv[++argIndex], 0, settings.warmupIterations)) { return false; }
+			}
+			else if ((argument == "--pin") && hasValue)
+			{
+				unsigned int cpu{ 0 };
+				if (!ParseSetting(argv[++argIndex], 0, cpu)) { return false; }
+				settings.pinnedCpu = static_cast<int>(cpu);
+			}
+			else if (argument == "--verify")
+			{
+				settings.verifyAnswers = true;
+			}
+			else if (argument == "--parsing")
+			{
+				settings.benchmarkParsing = true;
+			}
+			else
+			{
+				unsigned int day{ 0 };
+				if (!ParseSetting(argument, 1, day) || (day > PuzzleSolvers::numberOfPuzzleSolvers)) { return false; }
+				settings.days.push_back(day);
+			}
+		}
+
+		if (settings.days.empty())
+		{
+			for (unsigned int day = 1; day <= PuzzleSolvers::numberOfPuzzleSolvers; day++)
+			{
+				settings.days.push_back(day);
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	AllocationTracking::EnableTracking();
+
+	BenchmarkSettings settings{};
+	if (!ParseArguments(argc, argv, settings))
+	{
+		std::cout << "Usage: AoC_Benchmark [--iterations N] [--warmup N] [--pin CPU] [--verify] [--parsing] [day...]" << std::endl;
+		return CommandLine::exitCodeBadArguments;
+	}
+
+	if ((settings.pinnedCpu >= 0) && !PinToCpu(settings.pinnedCpu))
+	{
+		std::cout << "Failed to pin to CPU " << settings.pinnedCpu << ", continuing unpinned" << std::endl;
+	}
+
+	if (settings.benchmarkParsing)
+	{
+		std::cout << std::fixed;
+		return BenchmarkLineParsers(settings) ? CommandLine::exitCodeSuccess : CommandLine::exitCodeAnswerMismatch;
+	}
+
+	if (!InputRetrieval::CheckPuzzleInputsCanBeOpened(settings.days))
+	{
+		return CommandLine::exitCodeMissingInput;
+	}
+	InputRetrieval::PreloadPuzzleInputs(settings.days, true);
+
+	// There's no point benchmarking anything if we can't then check it when verifying.
+	std::map<unsigned int, PuzzleAnswerPair> expectedAnswers{};
+	if (settings.verifyAnswers)
+	{
+		for (unsigned int day : settings.days)
+		{
+			std::optional<PuzzleAnswerPair> expectedAnswersForDay = AnswerVerification::FindExpectedAnswers(day);
+			if (!expectedAnswersForDay)
+			{
+				std::cout << "No expected answers recorded for day " << day << "'s input " <<
+					InputRetrieval::GetPathToPuzzleInput(day) << std::endl;
+				return CommandLine::exitCodeMissingExpectedAnswers;
+			}
+			expectedAnswers[day] = *expectedAnswersForDay;
+		}
+	}
+
+	std::cout << settings.warmupIterations << " warm-up and " << settings.iterations <<
+		" timed runs per day" << std::endl << std::endl;
+	std::cout << " Day |   Min (ms) | Median (ms) |   p99 (ms) | Allocs/run |  Bytes/run |  Peak live" << std::endl;
+	std::cout << "-----+------------+-------------+------------+------------+------------+-----------" << std::endl;
+	std::cout << std::fixed;
+	bool anyAnswerMismatched{ false };
+	for (unsigned int day : settings.days)
+	{
+		auto expectedItr = expectedAnswers.find(day);
+		PuzzleAnswerPair const* expectedAnswersForDay =
+			(expectedItr != expectedAnswers.end()) ? &expectedItr->second : nullptr;
+		BenchmarkResult result = BenchmarkDay(day, settings, expectedAnswersForDay);
+		std::cout << std::setprecision(3) <<
+			std::setw(4) << result.day << " | " <<
+			std::setw(10) << result.minMilliseconds << " | " <<
+			std::setw(11) << result.medianMilliseconds << " | " <<
+			std::setw(10) << result.p99Milliseconds << " | " <<
+			std::setprecision(0) <<
+			std::setw(10) << result.allocationsPerRun << " | " <<
+			std::setw(10) << result.bytesPerRun << " | " <<
+			std::setw(10) << result.peakLiveBytes << std::endl;
+		if (!result.allAnswersMatched)
+		{
+			std::cout << "Day " << day << " answers don't match the expected " <<
+				expectedAnswersForDay->first << ", " << expectedAnswersForDay->second << std::endl;
+			anyAnswerMismatched = true;
+		}
+	}
+
+	// Exit codes are shared with the main solver.
+	return anyAnswerMismatched ? CommandLine::exitCodeAnswerMismatch : CommandLine::exitCodeSuccess;
+}
@@ -1,9 +1,255 @@
 #include "Parsing.h"
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARSING_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define PARSING_USE_SSE2
+#endif
+
+namespace
+{
+	// Finding the separators between numbers is done a block of characters at a time,
+	// giving a mask with a bit set for each character in the block which is either the
+	// delimiter or a space. The block is as wide as the widest vector instructions the
+	// compiler has been told it can use, falling back to plain code a word at a time.
+#if defined(PARSING_USE_AVX2)
+	constexpr std::size_t separatorBlockSize = 32;
+	std::uint64_t SeparatorMask(char const* block, char delimiter)
+	{
+		__m256i characters = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block));
+		__m256i isDelimiter = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(delimiter));
+		__m256i isSpace = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(' '));
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(isDelimiter, isSpace)));
+	}
+#elif defined(PARSING_USE_SSE2)
+	constexpr std::size_t separatorBlockSize = 16;
+	std::uint64_t SeparatorMask(char const* block, char delimiter)
+	{
+		__m128i characters = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+		__m128i isDelimiter = _mm_cmpeq_epi8(characters, _mm_set1_epi8(delimiter));
+		__m128i isSpace = _mm_cmpeq_epi8(characters, _mm_set1_epi8(' '));
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(isDelimiter, isSpace)));
+	}
+#else
+	constexpr std::size_t separatorBlockSize = 8;
+	std::uint64_t SeparatorMask(char const* block, char delimiter)
+	{
+		std::uint64_t mask{ 0 };
+		for (std::size_t ii = 0; ii < separatorBlockSize; ii++)
+		{
+			if ((block[ii] == delimiter) || (block[ii] == ' ')) { mask |= (static_cast<std::uint64_t>(1) << ii); }
+		}
+		return mask;
+	}
+#endif
+
+	// Convert a run of digit characters to their values, a block at a time where we have
+	// vector instructions to hand. Anything that isn't a digit ends up as a value above 9,
+	// so the values are checked as they're converted, and false returned if any of them
+	// weren't digits.
+	[[nodiscard]] bool ConvertDigitCharacters(char const* characters, std::size_t count, std::uint8_t* digits)
+	{
+		std::size_t ii{ 0 };
+#if defined(PARSING_USE_AVX2)
+		__m256i valuesAboveNine = _mm256_setzero_si256();
+		for (; (ii + 32) <= count; ii += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(characters + ii));
+			__m256i values = _mm256_sub_epi8(block, _mm256_set1_epi8('0'));
+			valuesAboveNine = _mm256_or_si256(valuesAboveNine, _mm256_subs_epu8(values, _mm256_set1_epi8(9)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(digits + ii), values);
+		}
+		bool allDigits = _mm256_testz_si256(valuesAboveNine, valuesAboveNine) != 0;
+#elif defined(PARSING_USE_SSE2)
+		__m128i valuesAboveNine = _mm_setzero_si128();
+		for (; (ii + 16) <= count; ii += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(characters + ii));
+			__m128i values = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+			valuesAboveNine = _mm_or_si128(valuesAboveNine, _mm_subs_epu8(values, _mm_set1_epi8(9)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(digits + ii), values);
+		}
+		bool allDigits = _mm_movemask_epi8(_mm_cmpeq_epi8(valuesAboveNine, _mm_setzero_si128())) == 0xFFFF;
+#else
+		bool allDigits{ true };
+#endif
+		for (; ii < count; ii++)
+		{
+			digits[ii] = static_cast<std::uint8_t>(characters[ii] - '0');
+			allDigits &= (digits[ii] <= 9);
+		}
+		return allDigits;
+	}
+
+	// Convert a number of up to 8 digits in one go, given that it's safe to read 8
+	// characters from the start of the number. The characters are loaded as a single
+	// little-endian word with the first digit in the lowest byte, and shifted up so that
+	// anything after the number drops off the top and the missing leading digits become
+	// zeros. Neighbouring digits are then combined into pairs, and pairs of pairs, and so
+	// on, with a handful of multiplies rather than one per digit.
+	std::uint64_t ConvertUpToEightDigits(char const* digits, std::size_t numberOfDigits)
+	{
+		std::uint64_t word{ 0 };
+		std::memcpy(&word, digits, sizeof(word));
+		word -= 0x3030303030303030ULL;
+		word <<= (8 * (8 - numberOfDigits));
+		word = (word * 10) + (word >> 8);
+		word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+			(((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+		return word;
+	}
+
+	// Convert a single number from the line, which may have a leading minus sign for
+	// signed types. numberEnd is the end of the number itself, lineEnd the end of the line.
+	// As with ConvertNumber, anything that isn't entirely a number gives invalid_argument,
+	// and a number that doesn't fit in T gives result_out_of_range.
+	template <typename T>
+	Parsing::ConversionResult<T> ConvertInteger(char const* numberStart, char const* numberEnd, char const* lineEnd)
+	{
+		Parsing::ConversionResult<T> result{};
+		bool isNegative = (*numberStart == '-');
+		if (isNegative)
+		{
+			if (!std::is_signed<T>::value)
+			{
+				result.error = std::errc::invalid_argument;
+				return result;
+			}
+			numberStart++;
+		}
+
+		std::size_t numberOfDigits = numberEnd - numberStart;
+		if ((numberOfDigits == 0) || !std::all_of(numberStart, numberEnd, [](char digit) { return (digit >= '0') && (digit <= '9'); }))
+		{
+			result.error = std::errc::invalid_argument;
+			return result;
+		}
+
+		// The most a negative number's magnitude can be is one more than the most a positive
+		// number can be. Anything past that, even if it would fit in a ULLINT, is out of range.
+		constexpr ULLINT largestPositive = static_cast<ULLINT>(std::numeric_limits<T>::max());
+		ULLINT const largestMagnitude = isNegative ? (largestPositive + 1) : largestPositive;
+		ULLINT magnitude{ 0 };
+		if ((numberOfDigits <= 8) && ((lineEnd - numberStart) >= 8))
+		{
+			magnitude = ConvertUpToEightDigits(numberStart, numberOfDigits);
+		}
+		else
+		{
+			for (char const* digit = numberStart; digit < numberEnd; digit++)
+			{
+				ULLINT digitValue = static_cast<ULLINT>(*digit - '0');
+				if (magnitude > ((std::numeric_limits<ULLINT>::max() - digitValue) / 10))
+				{
+					result.error = std::errc::result_out_of_range;
+					return result;
+				}
+				magnitude = (magnitude * 10) + digitValue;
+			}
+		}
+
+		if (magnitude > largestMagnitude)
+		{
+			result.error = std::errc::result_out_of_range;
+			return result;
+		}
+		result.value = isNegative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+		return result;
+	}
+}
+
+// Work along the line a block at a time, using each block's separator mask to find where
+// numbers start (a non-separator following a separator) and end (a separator following a
+// non-separator). Whether the character before the block was a separator is carried over
+// from one block to the next, and the start of the line counts as following a separator.
+// The last partial block is copied into a block padded out with spaces.
+template <typename T>
+std::errc Parsing::ParseDelimitedIntegers(std::string_view line, char delimiter, std::vector<T>& values)
+{
+	std::size_t firstNewValue = values.size();
+	values.resize(firstNewValue + (line.size() / 2) + 1);
+	T* nextValue = values.data() + firstNewValue;
+
+	char const* lineStart = line.data();
+	char const* lineEnd = lineStart + line.size();
+	char const* numberStart{ nullptr };
+	std::uint64_t previousWasSeparator{ 1 };
+	char paddedBlock[separatorBlockSize];
+	for (std::size_t blockStart = 0; blockStart < line.size(); blockStart += separatorBlockSize)
+	{
+		char const* block = lineStart + blockStart;
+		if ((line.size() - blockStart) < separatorBlockSize)
+		{
+			std::memset(paddedBlock, ' ', separatorBlockSize);
+			std::memcpy(paddedBlock, block, line.size() - blockStart);
+			block = paddedBlock;
+		}
+
+		std::uint64_t separators = SeparatorMask(block, delimiter);
+		std::uint64_t notSeparators = ~separators & ((separatorBlockSize == 64) ? ~0ULL : ((1ULL << separatorBlockSize) - 1));
+		std::uint64_t numberStarts = notSeparators & ((separators << 1) | previousWasSeparator);
+		std::uint64_t numberEnds = separators & ~((separators << 1) | previousWasSeparator);
+		previousWasSeparator = (separators >> (separatorBlockSize - 1)) & 1;
+
+		// Starts and ends alternate, so take whichever is due next until this block runs out
+		// of the one we're waiting for.
+		while (true)
+		{
+			if (numberStart == nullptr)
+			{
+				if (numberStarts == 0) { break; }
+				numberStart = lineStart + blockStart + std::countr_zero(numberStarts);
+				numberStarts &= (numberStarts - 1);
+			}
+			else
+			{
+				if (numberEnds == 0) { break; }
+				char const* numberEnd = lineStart + blockStart + std::countr_zero(numberEnds);
+				numberEnds &= (numberEnds - 1);
+				ConversionResult<T> converted = ConvertInteger<T>(numberStart, numberEnd, lineEnd);
+				if (!converted.Succeeded())
+				{
+					values.resize(firstNewValue);
+					return converted.error;
+				}
+				*nextValue++ = converted.value;
+				numberStart = nullptr;
+			}
+		}
+	}
+
+	// A number running up to the end of the line has no separator after it.
+	if (numberStart != nullptr)
+	{
+		ConversionResult<T> converted = ConvertInteger<T>(numberStart, lineEnd, lineEnd);
+		if (!converted.Succeeded())
+		{
+			values.resize(firstNewValue);
+			return converted.error;
+		}
+		*nextValue++ = converted.value;
+	}
+	values.resize(nextValue - values.data());
+	return std::errc{};
+}
+
+template std::errc Parsing::ParseDelimitedIntegers<int>(std::string_view line, char delimiter, std::vector<int>& values);
+template std::errc Parsing::ParseDelimitedIntegers<unsigned int>(std::string_view line, char delimiter, std::vector<unsigned int>& values);
+template std::errc Parsing::ParseDelimitedIntegers<LLINT>(std::string_view line, char delimiter, std::vector<LLINT>& values);
+template std::errc Parsing::ParseDelimitedIntegers<ULLINT>(std::string_view line, char delimiter, std::vector<ULLINT>& values);
 
 // Stream the next portion of the input file into a string, and return that string.
 // Makes no assumptions about the position of the read pointer, and will leave the
 // read pointer at the end of the read string.
-std::string Parsing::ReadSingleStringFromInputFile(std::ifstream& inputFile)
+std::string Parsing::ReadSingleStringFromInputFile(std::istream& inputFile)
 {
 	std::string stringFromFile{};
 	inputFile >> stringFromFile;
@@ -13,7 +259,7 @@ std::string Parsing::ReadSingleStringFromInputFile(std::ifstream& inputFile)
 // Stream the next line of the input file into a string, and return that string.
 // Makes no assumptions about the position of the read pointer, and will leave the
 // read pointer at the start of the next line.
-std::string Parsing::ReadWholeLineFromInputFile(std::ifstream& inputFile)
+std::string Parsing::ReadWholeLineFromInputFile(std::istream& inputFile)
 {
 	std::string stringFromFile{};
 	std::getline(inputFile, stringFromFile);
@@ -24,7 +270,7 @@ std::string Parsing::ReadWholeLineFromInputFile(std::ifstream& inputFile)
 // This function will assume the get pointer for the input file stream
 // is already in the correct position, and will not close the file once
 // done parsing, that's all up to the caller.
-std::vector<std::string> Parsing::SeparateRemainingInputIntoLines(std::ifstream & inputFile)
+std::vector<std::string> Parsing::SeparateRemainingInputIntoLines(std::istream& inputFile)
 {
 	std::vector<std::string> parsedLines{};
 	unsigned int linesParsed = 0;
@@ -38,127 +284,163 @@ std::vector<std::string> Parsing::SeparateRemainingInputIntoLines(std::ifstream
 	return parsedLines;
 }
 
+// As above, but with the lines held in the arena rather than each in its own string. The
+// views stay valid for as long as the arena's contents do.
+std::vector<std::string_view> Parsing::SeparateRemainingInputIntoLines(std::istream& inputFile, StringArena& arena)
+{
+	std::vector<std::string_view> parsedLines{};
+	std::string currentLine{};
+
+	while (!inputFile.eof())
+	{
+		std::getline(inputFile, currentLine);
+		parsedLines.push_back(arena.Store(currentLine));
+	}
+
+	return parsedLines;
+}
+
 // Moves the get pointer for an input file stream to the start of the next line.
 // Primary use case is to skip blank lines in input files.
-void Parsing::SeekNextLine(std::ifstream & inputFile)
+void Parsing::SeekNextLine(std::istream& inputFile)
 {
 	std::string dummyString;
 	std::getline(inputFile, dummyString);
 }
 
-// Parse an input file stream consisting of a grid of digits with no whitespace
-// other than the newline between each line of the grid. Return a 2D vector representing
-// this grid, where the 0th row of that 2D vector is the first line from the file.
-// This function will assume the get pointer for the input file stream
-// is already in the correct position, and will not close the file once
-// done parsing, that's all up to the caller.
-std::vector<std::vector<int>> Parsing::ParseWhitespacelessGridOfDigits(std::ifstream & inputFile)
+// Hand out the next size bytes of the current block, starting a new block if there isn't
+// room left in this one. Anything bigger than a block gets a block all of its own, and
+// whatever was left of the current block carries on being used after that.
+char* Parsing::StringArena::Allocate(std::size_t size)
 {
-	std::string currentLine;
-	std::vector<std::vector<int>> gridOfInts{};
-	while (!inputFile.eof())
+	if (size > blockSize)
 	{
-		inputFile >> currentLine;
+		blocks.push_back(std::make_unique<char[]>(size));
+		return blocks.back().get();
+	}
 
-		std::vector<int> gridLine{};
-		for (char digit : currentLine)
-		{
-			gridLine.push_back(digit - '0');
-		}
-		gridOfInts.push_back(gridLine);
+	if (size > spaceRemaining)
+	{
+		blocks.push_back(std::make_unique<char[]>(blockSize));
+		nextFree = blocks.back().get();
+		spaceRemaining = blockSize;
 	}
-	return gridOfInts;
+
+	char* allocation = nextFree;
+	nextFree += size;
+	spaceRemaining -= size;
+	return allocation;
 }
 
-// Given string representing a hex number, return a string representing the equivalent
-// binary. e.g. "3A2" would return "001110100010".
-std::string Parsing::ConvertHexStringToBinary(std::string hexString)
+// Copy some text into the arena. A null terminator is stored after every string, which
+// also means that no two strings ever start at the same address, even empty ones.
+std::string_view Parsing::StringArena::Store(std::string_view text)
 {
-	std::string binaryString{};
+	char* storedText = Allocate(text.size() + 1);
+	std::memcpy(storedText, text.data(), text.size());
+	storedText[text.size()] = '\0';
+	bytesStored += text.size() + 1;
+	return std::string_view{ storedText, text.size() };
+}
 
-	for (char character : hexString)
+// Free everything in the arena at once. Any views previously handed out are left dangling.
+void Parsing::StringArena::Clear()
+{
+	blocks.clear();
+	nextFree = nullptr;
+	spaceRemaining = 0;
+	bytesStored = 0;
+}
+
+// The set holds views into the arena, so looking text up in it compares by content, while
+// the views it hands back can be compared by address.
+Parsing::InternedString Parsing::StringInterner::Intern(std::string_view text)
+{
+	auto existingText = internedText.find(text);
+	if (existingText != internedText.end()) { return InternedString{ *existingText }; }
+	return InternedString{ *internedText.insert(arena.Store(text)).first };
+}
+
+// Parse a grid of digits with no whitespace other than the newline between each row, into a
+// single flat buffer of bytes. Each line is read into the same string, and its digits
+// converted straight onto the end of the buffer. Reading stops at the end of the file or at
+// the first blank line. A row that isn't the same width as the first, or that has anything
+// other than digits in it, is reported and stops the program.
+Parsing::DigitGrid Parsing::ParseDigitGrid(std::istream& inputFile)
+{
+	DigitGrid grid{};
+	std::string currentLine{};
+	while (std::getline(inputFile, currentLine))
 	{
-		switch (character)
+		if (!currentLine.empty() && (currentLine.back() == '\r')) { currentLine.pop_back(); }
+		if (currentLine.empty()) { break; }
+
+		if (grid.height == 0) { grid.width = static_cast<unsigned int>(currentLine.size()); }
+		if (currentLine.size() != grid.width)
 		{
-		case '0':
-			binaryString += binaryZero;
-			break;
-		case '1':
-			binaryString += binaryOne;
-			break;
-		case '2':
-			binaryString += binaryTwo;
-			break;
-		case '3':
-			binaryString += binaryThree;
-			break;
-		case '4':
-			binaryString += binaryFour;
-			break;
-		case '5':
-			binaryString += binaryFive;
-			break;
-		case '6':
-			binaryString += binarySix;
-			break;
-		case '7':
-			binaryString += binarySeven;
-			break;
-		case '8':
-			binaryString += binaryEight;
-			break;
-		case '9':
-			binaryString += binaryNine;
-			break;
-		case 'A':
-		case 'a':
-			binaryString += binaryA;
-			break;
-		case 'B':
-		case 'b':
-			binaryString += binaryB;
-			break;
-		case 'C':
-		case 'c':
-			binaryString += binaryC;
-			break;
-		case 'D':
-		case 'd':
-			binaryString += binaryD;
-			break;
-		case 'E':
-		case 'e':
-			binaryString += binaryE;
-			break;
-		case 'F':
-		case 'f':
-			binaryString += binaryF;
-			break;
-		default:
-			assert(false);
-			break;
+			ReportMalformedLine(currentLine, "a row of " + std::to_string(grid.width) + " digits");
 		}
-	}
 
-	return binaryString;
+		std::size_t rowStart = grid.digits.size();
+		grid.digits.resize(rowStart + grid.width);
+		if (!ConvertDigitCharacters(currentLine.data(), grid.width, grid.digits.data() + rowStart))
+		{
+			ReportInvalidNumber(currentLine, std::errc::invalid_argument);
+		}
+		grid.height++;
+	}
+	return grid;
 }
 
-ULLINT Parsing::ConvertBinaryToInt(std::string binaryString)
+// Pack the hex digits two to a byte, the first digit of each pair in the high nibble. An
+// odd number of digits leaves the low nibble of the last byte as zero, which is never read
+// since it's past the end of the bits.
+Parsing::HexBitReader::HexBitReader(std::string_view hexString)
+	: packedBits((hexString.size() + 1) / 2, 0), numberOfBits(hexString.size() * 4)
 {
-	ULLINT currentBitValue = 1;
-	for (unsigned int ii = 1; ii < binaryString.size(); ii++) { currentBitValue *= 2; }
+	for (std::size_t ii = 0; ii < hexString.size(); ii++)
+	{
+		packedBits[ii / 2] |= HexDigitValue(hexString[ii]) << ((ii % 2 == 0) ? 4 : 0);
+	}
+}
 
-	ULLINT totalValue{ 0 };
+// Work through the bytes the field covers, taking as many of the wanted bits from each as
+// it holds. Only the first and last bytes can be partially covered by the field.
+ULLINT Parsing::HexBitReader::ReadBits(unsigned int numberOfBitsToRead)
+{
+	assert(numberOfBitsToRead <= 64);
+	assert(numberOfBitsToRead <= BitsRemaining());
 
-	for (char bit : binaryString)
+	ULLINT value{ 0 };
+	unsigned int bitsLeftToRead = numberOfBitsToRead;
+	while (bitsLeftToRead > 0)
 	{
-		if (bit == '1') { totalValue += currentBitValue; }
-		currentBitValue /= 2;
+		unsigned int bitInByte = position % 8;
+		unsigned int bitsFromThisByte = std::min(bitsLeftToRead, 8 - bitInByte);
+		unsigned int byteValue = packedBits[position / 8];
+		unsigned int wantedBits = (byteValue >> (8 - bitInByte - bitsFromThisByte)) & ((1u << bitsFromThisByte) - 1);
+
+		value = (value << bitsFromThisByte) | wantedBits;
+		position += bitsFromThisByte;
+		bitsLeftToRead -= bitsFromThisByte;
 	}
-	return totalValue;
+	return value;
+}
+
+void Parsing::ReportInvalidNumber(std::string_view text, std::errc error)
+{
+	std::cerr << "Couldn't convert \"" << text << "\" to a number: " <<
+		std::make_error_code(error).message() << std::endl;
+	std::abort();
+}
+
+void Parsing::ReportMalformedLine(std::string_view line, std::string_view expectedLayout)
+{
+	std::cerr << "Couldn't parse \"" << line << "\" as \"" << expectedLayout << "\"" << std::endl;
+	std::abort();
 }
 
 int Parsing::ConvertStringToInt(std::string stringToConvert)
 {
-	return std::strtol(stringToConvert.c_str(), nullptr, 10);
+	return ConvertValidNumber<int>(stringToConvert);
 }
@@ -0,0 +1,199 @@
+#include "allocation_tracking.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+// Over-aligned memory comes from a different allocator on Windows, which has to be asked
+// for the size and freed differently too.
+#if defined(_WIN32)
+#include <malloc.h>
+#define ALLOCATION_SIZE(memory) _msize(memory)
+#define ALIGNED_ALLOCATION_SIZE(memory, alignment) _aligned_msize(memory, alignment, 0)
+#define ALIGNED_FREE(memory) _aligned_free(memory)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define ALLOCATION_SIZE(memory) malloc_size(memory)
+#define ALIGNED_ALLOCATION_SIZE(memory, alignment) malloc_size(memory)
+#define ALIGNED_FREE(memory) std::free(memory)
+#else
+#include <malloc.h>
+#define ALLOCATION_SIZE(memory) malloc_usable_size(memory)
+#define ALIGNED_ALLOCATION_SIZE(memory, alignment) malloc_usable_size(memory)
+#define ALIGNED_FREE(memory) std::free(memory)
+#endif
+
+namespace
+{
+	std::atomic<bool> trackingEnabled{ false };
+
+	// Every thread updates the same counters, which only need to be atomic rather than
+	// ordered with respect to anything else.
+	std::atomic<ULLINT> totalAllocations{ 0 };
+	std::atomic<ULLINT> totalBytesAllocated{ 0 };
+	std::atomic<LLINT> liveBytes{ 0 };
+	std::atomic<LLINT> peakLiveBytes{ 0 };
+
+	// Raise the peak to the new number of live bytes, unless another thread has already
+	// raised it further.
+	void UpdatePeakLiveBytes(LLINT newLiveBytes)
+	{
+		LLINT currentPeak = peakLiveBytes.load(std::memory_order_relaxed);
+		while ((newLiveBytes > currentPeak) &&
+			!peakLiveBytes.compare_exchange_weak(currentPeak, newLiveBytes, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Live bytes are counted using the size the allocator actually handed out, since that's
+	// all we can find out again when the memory is freed.
+	void CountAllocation(std::size_t size, std::size_t allocatedSize)
+	{
+		totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		totalBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+		LLINT allocatedBytes = static_cast<LLINT>(allocatedSize);
+		UpdatePeakLiveBytes(liveBytes.fetch_add(allocatedBytes, std::memory_order_relaxed) + allocatedBytes);
+	}
+
+	// Every flavour of operator new without an alignment ends up here. The memory itself
+	// comes straight from malloc, and we just keep count.
+	void* TrackedAllocate(std::size_t size)
+	{
+		void* memory = std::malloc(size == 0 ? 1 : size);
+		if ((memory != nullptr) && trackingEnabled.load(std::memory_order_relaxed))
+		{
+			CountAllocation(size, ALLOCATION_SIZE(memory));
+		}
+		return memory;
+	}
+
+	void TrackedFree(void* memory)
+	{
+		if ((memory != nullptr) && trackingEnabled.load(std::memory_order_relaxed))
+		{
+			liveBytes.fetch_sub(static_cast<LLINT>(ALLOCATION_SIZE(memory)), std::memory_order_relaxed);
+		}
+		std::free(memory);
+	}
+
+	// And every flavour with an alignment greater than malloc guarantees ends up here.
+	void* TrackedAllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		std::size_t const alignmentBytes = static_cast<std::size_t>(alignment);
+		std::size_t const sizeToAllocate = (size == 0) ? 1 : size;
+#if defined(_WIN32)
+		void* memory = _aligned_malloc(sizeToAllocate, alignmentBytes);
+#else
+		void* memory{ nullptr };
+		if (posix_memalign(&memory, std::max(alignmentBytes, sizeof(void*)), sizeToAllocate) != 0) { memory = nullptr; }
+#endif
+		if ((memory != nullptr) && trackingEnabled.load(std::memory_order_relaxed))
+		{
+			CountAllocation(size, ALIGNED_ALLOCATION_SIZE(memory, alignmentBytes));
+		}
+		return memory;
+	}
+
+	void TrackedFreeAligned(void* memory, [[maybe_unused]] std::align_val_t alignment)
+	{
+		if ((memory != nullptr) && trackingEnabled.load(std::memory_order_relaxed))
+		{
+			liveBytes.fetch_sub(static_cast<LLINT>(ALIGNED_ALLOCATION_SIZE(memory, static_cast<std::size_t>(alignment))), std::memory_order_relaxed);
+		}
+		ALIGNED_FREE(memory);
+	}
+}
+
+void AllocationTracking::EnableTracking()
+{
+	trackingEnabled.store(true, std::memory_order_relaxed);
+}
+
+bool AllocationTracking::IsTrackingEnabled()
+{
+	return trackingEnabled.load(std::memory_order_relaxed);
+}
+
+AllocationTracking::AllocationStats AllocationTracking::CurrentStats()
+{
+	return AllocationStats{
+		totalAllocations.load(std::memory_order_relaxed),
+		totalBytesAllocated.load(std::memory_order_relaxed),
+		liveBytes.load(std::memory_order_relaxed),
+		peakLiveBytes.load(std::memory_order_relaxed) };
+}
+
+void AllocationTracking::ResetPeakLiveBytes()
+{
+	peakLiveBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void AllocationTracking::PrintAllocationTable(std::ostream& outputStream, std::vector<DayAllocations> const& allAllocations)
+{
+	outputStream << " Day | Allocations |      Bytes | Peak live bytes" << std::endl;
+	outputStream << "-----+-------------+------------+----------------" << std::endl;
+	for (DayAllocations const& dayAllocations : allAllocations)
+	{
+		outputStream <<
+			std::setw(4) << dayAllocations.day << " | " <<
+			std::setw(11) << dayAllocations.stats.allocations << " | " <<
+			std::setw(10) << dayAllocations.stats.bytesAllocated << " | " <<
+			std::setw(15) << dayAllocations.stats.peakLiveBytes << std::endl;
+	}
+}
+
+// Replacements for the global allocation functions. The throwing versions have to
+// throw on failure like the originals, while the nothrow versions hand back nullptr.
+void* operator new(std::size_t size)
+{
+	void* memory = TrackedAllocate(size);
+	if (memory == nullptr) { throw std::bad_alloc{}; }
+	return memory;
+}
+void* operator new[](std::size_t size)
+{
+	void* memory = TrackedAllocate(size);
+	if (memory == nullptr) { throw std::bad_alloc{}; }
+	return memory;
+}
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size);
+}
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size);
+}
+void operator delete(void* memory) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, std::nothrow_t const&) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, std::nothrow_t const&) noexcept { TrackedFree(memory); }
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	void* memory = TrackedAllocateAligned(size, alignment);
+	if (memory == nullptr) { throw std::bad_alloc{}; }
+	return memory;
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	void* memory = TrackedAllocateAligned(size, alignment);
+	if (memory == nullptr) { throw std::bad_alloc{}; }
+	return memory;
+}
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocateAligned(size, alignment);
+}
+void operator delete(void* memory, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete(void* memory, std::align_val_t alignment, std::nothrow_t const&) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment, std::nothrow_t const&) noexcept { TrackedFreeAligned(memory, alignment); }
\ No newline at end of file
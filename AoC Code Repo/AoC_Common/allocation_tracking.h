@@ -0,0 +1,54 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include "aoc_common_types.h"
+
+// Counts the heap allocations made by the program, by replacing the global operator new
+// and delete. Only a project which compiles allocation_tracking.cpp gets the replacement
+// operators, and even then nothing is counted until tracking is switched on, so that
+// normal runs don't pay for it.
+// The counts are shared by every thread in the program, so that the work a solver hands
+// out to worker threads is counted along with its own, and memory freed on a different
+// thread to the one which allocated it still balances out. This does mean that anything
+// else running at the same time would be counted too, so only one piece of code should be
+// measured at a time (the solver won't track allocations while solving days in parallel).
+// The totals are cumulative over the life of the program, so the usual pattern is to take
+// a snapshot before and after the code of interest and subtract one from the other.
+namespace AllocationTracking
+{
+	struct AllocationStats
+	{
+		ULLINT allocations{ 0 };
+		ULLINT bytesAllocated{ 0 };
+		LLINT liveBytes{ 0 };
+		LLINT peakLiveBytes{ 0 };
+
+		// The peak of the difference is how far the later peak rose above the bytes that
+		// were already live at the earlier snapshot, so ResetPeakLiveBytes should be
+		// called when the earlier snapshot is taken.
+		AllocationStats operator-(AllocationStats const& earlierStats) const
+		{
+			return AllocationStats{
+				allocations - earlierStats.allocations,
+				bytesAllocated - earlierStats.bytesAllocated,
+				liveBytes - earlierStats.liveBytes,
+				peakLiveBytes - earlierStats.liveBytes };
+		}
+	};
+
+	// Tracking should be switched on before the code of interest starts allocating, and
+	// left on, since memory allocated while it was off isn't known about when it's freed.
+	void EnableTracking();
+	bool IsTrackingEnabled();
+
+	AllocationStats CurrentStats();
+	void ResetPeakLiveBytes();
+
+	struct DayAllocations
+	{
+		unsigned int day;
+		AllocationStats stats;
+	};
+
+	void PrintAllocationTable(std::ostream& outputStream, std::vector<DayAllocations> const& allAllocations);
+}
@@ -11,7 +11,13 @@
 // Each day's puzzle will take a input filestream to that day's input, and return a pair
 // of answers (one for each part of the puzzle).
 using PuzzleAnswerPair = std::pair<std::string, std::string>;
-using PuzzleFunc = PuzzleAnswerPair(*)(std::ifstream&);
+using PuzzleFunc = PuzzleAnswerPair(*)(std::istream&);
+
+// Solvers are gradually moving over to reading their input straight out of a memory
+// mapped file (see puzzle_input.h) rather than through a filestream. Solvers which
+// haven't been moved over yet are wrapped up to look like one that has.
+namespace PuzzleInput { class MappedFile; }
+using PuzzleInputFunc = PuzzleAnswerPair(*)(PuzzleInput::MappedFile const&);
 
 // The unsigned long long int is pretty much the primary type of advent of code, so let's
 // save ourselves some typing.
@@ -0,0 +1,182 @@
+#include "grid_utils.h"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GRID_UTILS_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GRID_UTILS_USE_SSE2
+#endif
+
+namespace
+{
+	// The byte stencils below work through a row a block of cells at a time, loading each
+	// neighbour of the whole block at once from the rows above and below and from either
+	// side. The block is as wide as the widest vector instructions the compiler has been
+	// told it can use, with any cells left over at the end of the row done one at a time.
+#if defined(GRID_UTILS_USE_AVX2)
+	using ByteBlock = __m256i;
+	constexpr unsigned int bytesPerBlock = 32;
+	ByteBlock LoadBlock(std::uint8_t const* cells) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(cells)); }
+	void StoreBlock(std::uint8_t* cells, ByteBlock block) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(cells), block); }
+	ByteBlock AddBlocks(ByteBlock first, ByteBlock second) { return _mm256_add_epi8(first, second); }
+	ByteBlock OrBlocks(ByteBlock first, ByteBlock second) { return _mm256_or_si256(first, second); }
+	ByteBlock AllBytes(std::uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+
+	// 0xFF in each byte where neighbour <= centre, otherwise 0.
+	ByteBlock NotHigher(ByteBlock neighbour, ByteBlock centre)
+	{
+		return _mm256_cmpeq_epi8(_mm256_min_epu8(neighbour, centre), neighbour);
+	}
+	// 1 in each byte where the mask is 0, otherwise 0.
+	ByteBlock OneWhereClear(ByteBlock mask) { return _mm256_andnot_si256(mask, AllBytes(1)); }
+#elif defined(GRID_UTILS_USE_SSE2)
+	using ByteBlock = __m128i;
+	constexpr unsigned int bytesPerBlock = 16;
+	ByteBlock LoadBlock(std::uint8_t const* cells) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(cells)); }
+	void StoreBlock(std::uint8_t* cells, ByteBlock block) { _mm_storeu_si128(reinterpret_cast<__m128i*>(cells), block); }
+	ByteBlock AddBlocks(ByteBlock first, ByteBlock second) { return _mm_add_epi8(first, second); }
+	ByteBlock OrBlocks(ByteBlock first, ByteBlock second) { return _mm_or_si128(first, second); }
+	ByteBlock AllBytes(std::uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+	ByteBlock NotHigher(ByteBlock neighbour, ByteBlock centre)
+	{
+		return _mm_cmpeq_epi8(_mm_min_epu8(neighbour, centre), neighbour);
+	}
+	ByteBlock OneWhereClear(ByteBlock mask) { return _mm_andnot_si128(mask, AllBytes(1)); }
+#endif
+
+	// Pointers to the first cell of a block in the rows below, at and above the cells being
+	// worked out.
+	struct RowPointers
+	{
+		std::uint8_t const* below;
+		std::uint8_t const* centre;
+		std::uint8_t const* above;
+	};
+
+	// The rows passed to these point at the cell itself, so its neighbours either side are
+	// at [-1] and [1].
+	std::uint8_t NeighbourSumOfCell(RowPointers cell, GridUtils::Neighbourhood neighbourhood)
+	{
+		unsigned int sum = cell.below[0] + cell.centre[-1] + cell.centre[1] + cell.above[0];
+		if (neighbourhood == GridUtils::Neighbourhood::EightNeighbours)
+		{
+			sum += cell.below[-1] + cell.below[1] + cell.above[-1] + cell.above[1];
+		}
+		return static_cast<std::uint8_t>(sum);
+	}
+
+	std::uint8_t StrictLocalMinimumOfCell(RowPointers cell, GridUtils::Neighbourhood neighbourhood)
+	{
+		std::uint8_t centre = cell.centre[0];
+		bool isMinimum = (centre < cell.below[0]) && (centre < cell.centre[-1]) &&
+			(centre < cell.centre[1]) && (centre < cell.above[0]);
+		if (neighbourhood == GridUtils::Neighbourhood::EightNeighbours)
+		{
+			isMinimum = isMinimum && (centre < cell.below[-1]) && (centre < cell.below[1]) &&
+				(centre < cell.above[-1]) && (centre < cell.above[1]);
+		}
+		return isMinimum ? 1 : 0;
+	}
+
+	void NeighbourSumsOfRow(RowPointers rows, std::uint8_t* sums, unsigned int width, GridUtils::Neighbourhood neighbourhood)
+	{
+		unsigned int x{ 0 };
+#if defined(GRID_UTILS_USE_AVX2) || defined(GRID_UTILS_USE_SSE2)
+		for (; (x + bytesPerBlock) <= width; x += bytesPerBlock)
+		{
+			ByteBlock sum = AddBlocks(
+				AddBlocks(LoadBlock(rows.below + x), LoadBlock(rows.above + x)),
+				AddBlocks(LoadBlock(rows.centre + x - 1), LoadBlock(rows.centre + x + 1)));
+			if (neighbourhood == GridUtils::Neighbourhood::EightNeighbours)
+			{
+				sum = AddBlocks(sum, AddBlocks(
+					AddBlocks(LoadBlock(rows.below + x - 1), LoadBlock(rows.below + x + 1)),
+					AddBlocks(LoadBlock(rows.above + x - 1), LoadBlock(rows.above + x + 1))));
+			}
+			StoreBlock(sums + x, sum);
+		}
+#endif
+		for (; x < width; x++)
+		{
+			sums[x] = NeighbourSumOfCell(RowPointers{ rows.below + x, rows.centre + x, rows.above + x }, neighbourhood);
+		}
+	}
+
+	void StrictLocalMinimaOfRow(RowPointers rows, std::uint8_t* minima, unsigned int width, GridUtils::Neighbourhood neighbourhood)
+	{
+		unsigned int x{ 0 };
+#if defined(GRID_UTILS_USE_AVX2) || defined(GRID_UTILS_USE_SSE2)
+		for (; (x + bytesPerBlock) <= width; x += bytesPerBlock)
+		{
+			// A cell is a strict minimum unless any neighbour is no higher than it.
+			ByteBlock centre = LoadBlock(rows.centre + x);
+			ByteBlock anyNotHigher = OrBlocks(
+				OrBlocks(NotHigher(LoadBlock(rows.below + x), centre), NotHigher(LoadBlock(rows.above + x), centre)),
+				OrBlocks(NotHigher(LoadBlock(rows.centre + x - 1), centre), NotHigher(LoadBlock(rows.centre + x + 1), centre)));
+			if (neighbourhood == GridUtils::Neighbourhood::EightNeighbours)
+			{
+				anyNotHigher = OrBlocks(anyNotHigher, OrBlocks(
+					OrBlocks(NotHigher(LoadBlock(rows.below + x - 1), centre), NotHigher(LoadBlock(rows.below + x + 1), centre)),
+					OrBlocks(NotHigher(LoadBlock(rows.above + x - 1), centre), NotHigher(LoadBlock(rows.above + x + 1), centre))));
+			}
+			StoreBlock(minima + x, OneWhereClear(anyNotHigher));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			minima[x] = StrictLocalMinimumOfCell(RowPointers{ rows.below + x, rows.centre + x, rows.above + x }, neighbourhood);
+		}
+	}
+
+	// Run a row function over every row of a padded grid, in bands if asked to.
+	template <typename RowFunction>
+	void ApplyByteStencil(
+		GridUtils::PaddedGrid<std::uint8_t> const& source,
+		GridUtils::PaddedGrid<std::uint8_t>& destination,
+		unsigned int rowBands,
+		RowFunction rowFunction)
+	{
+		assert((source.Width() == destination.Width()) && (source.Height() == destination.Height()));
+		GridUtils::ForEachRowBand(source.Height(), rowBands, [&](unsigned int firstRow, unsigned int endRow)
+			{
+				for (unsigned int y = firstRow; y < endRow; y++)
+				{
+					std::uint8_t const* centre = source.Row(y);
+					RowPointers rows{ centre - source.Stride(), centre, centre + source.Stride() };
+					rowFunction(rows, destination.Row(y), source.Width());
+				}
+			});
+	}
+}
+
+// Sum the neighbours of every cell. The sums wrap around past 255, the same as adding
+// up the bytes one at a time would.
+void GridUtils::NeighbourSums(
+	PaddedGrid<std::uint8_t> const& source,
+	PaddedGrid<std::uint8_t>& sums,
+	Neighbourhood neighbourhood,
+	unsigned int rowBands)
+{
+	ApplyByteStencil(source, sums, rowBands,
+		[neighbourhood](RowPointers rows, std::uint8_t* sumsRow, unsigned int width)
+		{
+			NeighbourSumsOfRow(rows, sumsRow, width, neighbourhood);
+		});
+}
+
+// Mark every cell that is lower than all of its neighbours. Halo cells count as
+// neighbours too, so a halo of 255 lets cells on the edge of the grid be minima.
+void GridUtils::StrictLocalMinima(
+	PaddedGrid<std::uint8_t> const& source,
+	PaddedGrid<std::uint8_t>& minima,
+	Neighbourhood neighbourhood,
+	unsigned int rowBands)
+{
+	ApplyByteStencil(source, minima, rowBands,
+		[neighbourhood](RowPointers rows, std::uint8_t* minimaRow, unsigned int width)
+		{
+			StrictLocalMinimaOfRow(rows, minimaRow, width, neighbourhood);
+		});
+}
@@ -1,11 +1,22 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <climits>
+#include <cstdint>
+#include <future>
+#include <iterator>
 #include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "aoc_common_types.h"
 
 // A fair few of the advent of code problems involve working with a grid of values.
 // This namespace provides utilities for working with such grids, including a grid
-// class that holds a 2D-vector of values and provides methods that let a user
+// class that holds a 2D block of values and provides methods that let a user
 // move around the cells within as well as reading/writing values.
 namespace GridUtils
 {
@@ -36,37 +47,82 @@ namespace GridUtils
 		}
 	};
 
-	// A 2D-vector of any required type. This grid does not hold those types directly, but
-	// instead holds a 2D-vector of 'grid cells', from the underlying value can be accessed,
-	// but which also provide methods for navigating the grid more easily than using
-	// increments/decrements on raw coordinates.
+	// A 2D grid of any required type. The values themselves are held in a single row-major
+	// block, so a Grid<char> takes up one byte per cell and neighbouring cells on a row sit
+	// next to each other in memory. Cells are accessed through 'grid cells', which refer
+	// back to a value in the grid but also provide methods for navigating the grid more
+	// easily than using increments/decrements on raw coordinates.
+	// Every cell hands out a reference to its value, which a std::vector<bool> can't do as
+	// it packs its values into bits, so a grid of bools should be a BitGrid instead.
 	template<typename T>
 	class Grid
 	{
+		static_assert(!std::is_same<bool, T>::value, "Grid<bool> can't hand out references to its cells, use a BitGrid instead");
+
 	public:
-		class GridCell;		
+		template <typename CellValue>
+		class BasicGridCell;
+		using GridCell = BasicGridCell<T>;
+		using ConstGridCell = BasicGridCell<T const>;
 
 	private:
-		std::vector<std::vector<GridCell>> grid;
+		std::vector<T> values{};
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+
+		std::size_t IndexOf(unsigned int x, unsigned int y) const
+		{
+			assert((x < width) && (y < height));
+			return (static_cast<std::size_t>(y) * width) + x;
+		}
+
+		// An empty grid with room already reserved for every cell, for the factories to
+		// build their values straight into.
+		Grid(unsigned int widthIn, unsigned int heightIn) : width{ widthIn }, height{ heightIn }
+		{
+			values.reserve(static_cast<std::size_t>(width) * height);
+		}
 
 	public:
-		// We declare the Grid constructor here but have to hold off on the definition until
-		// the GridCell nested class has been defined so that we can construct GridCells.
-		Grid(std::vector<std::vector<T>> gridIn);
+		// We declare the Grid constructors here but have to hold off on the definitions until
+		// the GridCell nested class has been defined.
+		// A 2D-vector is flattened into the grid's own storage, moving the values across
+		// when the 2D-vector is no longer needed.
+		Grid(std::vector<std::vector<T>> const& gridIn);
+		Grid(std::vector<std::vector<T>>&& gridIn);
+
+		// A grid can also be made from a single row-major block of values, such as a
+		// Parsing::DigitGrid, given how wide each row is. Moving the block in hands it over
+		// to the grid without copying any values.
+		Grid(std::vector<T> rowMajorValues, unsigned int width);
+
+		// A grid of the given size with every cell set to the same value.
+		Grid(unsigned int width, unsigned int height, T const& initialValue);
 
 		// Turn a 2D-vector of one type into a Grid of another, by applying a function to each
 		// element in the input grid. Useful for puzzles where we might have a grid of integers
 		// as input, but want to use a user-defined class to actually represent each element
 		// in that Grid.
-		template <typename TypeIn>
-		static Grid GridFactory(std::vector<std::vector<TypeIn>> gridIn, T(*cellConstructor)(TypeIn));
+		// The cell constructor can be any callable, so a lambda is inlined rather than called
+		// through a function pointer for every cell.
+		template <typename TypeIn, typename CellConstructor>
+		static Grid GridFactory(std::vector<std::vector<TypeIn>> const& gridIn, CellConstructor cellConstructor);
+		template <typename TypeIn, typename CellConstructor>
+		static Grid GridFactory(std::vector<TypeIn> const& rowMajorValuesIn, unsigned int width, CellConstructor cellConstructor);
 
-		unsigned int Height() const { return grid.size(); }
-		unsigned int Width() const { return grid[0].size(); }
+		unsigned int Height() const { return height; }
+		unsigned int Width() const { return width; }
 
-		// Cells within the grid can be accessed by read-only value, or read/write reference.
-		GridCell operator[] (Coordinate const &coord) const { return grid[coord.yPos][coord.xPos]; }
-		GridCell &operator[] (Coordinate const &coord) { return grid[coord.yPos][coord.xPos]; }
+		// The underlying row-major values, for code that wants to work through a whole row
+		// (or the whole grid) at once rather than cell by cell.
+		std::vector<T> const& Values() const { return values; }
+		std::vector<T>& Values() { return values; }
+
+		// Cells within the grid are looked up by coordinate. A GridCell is only a view onto
+		// the value held by the grid, so it's cheap to copy and stays valid for as long as
+		// the grid does. A const grid hands out ConstGridCells, which can only be read from.
+		GridCell operator[] (Coordinate const &coord);
+		ConstGridCell operator[] (Coordinate const &coord) const;
 
 		// The Grid provides begin() and end() functions that can be used to easily iterate
 		// over every value in it.
@@ -75,97 +131,77 @@ namespace GridUtils
 		Iterator end();
 	};
 
-	// A single cells within a grid of type T. Provides utility functions for accessing
-	// adjacent cells, and a publicly read/writable cell value.
+	// A single cell within a grid of type T. Provides utility functions for accessing
+	// adjacent cells, and a publicly readable reference to the cell value, which is also
+	// writable for a GridCell but not for a ConstGridCell. As with a pointer, a const
+	// GridCell can still be written through, it's only the cell's position that's fixed.
 	template <typename T>
-	class Grid<T>::GridCell
+	template <typename CellValue>
+	class Grid<T>::BasicGridCell
 	{
 	private:
-		Grid<T> &parentGrid;
-		const unsigned int x;
-		const unsigned int y;
+		using ParentGrid = std::conditional_t<std::is_const<CellValue>::value, Grid<T> const, Grid<T>>;
+		ParentGrid *parentGrid;
+		unsigned int x;
+		unsigned int y;
+
+		template <typename OtherCellValue>
+		friend class BasicGridCell;
 
 	public:
-		T value;
+		CellValue &value;
+
+		BasicGridCell(unsigned int xIn, unsigned int yIn, ParentGrid &grid) :
+			parentGrid{ &grid }, x{ xIn }, y{ yIn }, value{ grid.values[grid.IndexOf(xIn, yIn)] }{};
+
+		// Any cell can be read from, so a GridCell can be handed on as a ConstGridCell.
+		template <typename OtherCellValue>
+			requires (std::is_const<CellValue>::value && !std::is_const<OtherCellValue>::value)
+		BasicGridCell(BasicGridCell<OtherCellValue> const& otherCell) :
+			BasicGridCell{ otherCell.x, otherCell.y, *otherCell.parentGrid } {};
 
-		Grid<T>::GridCell(unsigned int xIn, unsigned int yIn, Grid<T> & grid, T valueIn) :
-			x{ xIn }, y{ yIn }, parentGrid{ grid }, value{ valueIn }{};
 		Coordinate GetCoordinate() const { return Coordinate{ x, y }; }
 
 		// Functions for determining whether a cell lies on one of the edges of the
 		// grid. Assume a grid with an origin of 0,0.
-		bool IsTopRow() const { return (y == (parentGrid.Height() - 1)); }
+		bool IsTopRow() const { return (y == (parentGrid->height - 1)); }
 		bool IsBottomRow() const { return (y == 0); }
-		bool IsRightColumn() const { return (x == (parentGrid.Width() - 1)); }
+		bool IsRightColumn() const { return (x == (parentGrid->width - 1)); }
 		bool IsLeftColumn() const { return (x == 0); }
 
 		// Functions for returning the adjacent cell in a given direction.
 		// Requires that there is actually a cell in that direction.
-		// Can either return the adjacent cell as read-only value (const version
-		// of the function) or read-write reference (non-const version of function);
-		GridCell Up() const {
-			assert(!IsTopRow());
-			return parentGrid[Coordinate(x, y + 1)]; 
-		}
-		GridCell &Up() {
+		BasicGridCell Up() const {
 			assert(!IsTopRow());
-			return parentGrid[Coordinate(x, y + 1)];
-		}
-		GridCell Down() const { 
-			assert(!IsBottomRow());
-			return parentGrid[Coordinate(x, y - 1)];
+			return BasicGridCell{ x, y + 1, *parentGrid };
 		}
-		GridCell &Down() {
+		BasicGridCell Down() const {
 			assert(!IsBottomRow());
-			return parentGrid[Coordinate(x, y - 1)];
+			return BasicGridCell{ x, y - 1, *parentGrid };
 		}
-		GridCell Right() const {
+		BasicGridCell Right() const {
 			assert(!IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y)];
+			return BasicGridCell{ x + 1, y, *parentGrid };
 		}
-		GridCell &Right() {
-			assert(!IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y)];
-		}
-		GridCell Left() const {
+		BasicGridCell Left() const {
 			assert(!IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y)];
-		}
-		GridCell &Left() {
-			assert(!IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y)];
-		}
-		GridCell UpRight() const {
-			assert(!IsTopRow() && !IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y + 1)];
+			return BasicGridCell{ x - 1, y, *parentGrid };
 		}
-		GridCell &UpRight() {
+		BasicGridCell UpRight() const {
 			assert(!IsTopRow() && !IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y + 1)];
-		}
-		GridCell DownRight() const {
-			assert(!IsBottomRow() && !IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y - 1)];
+			return BasicGridCell{ x + 1, y + 1, *parentGrid };
 		}
-		GridCell &DownRight() {
+		BasicGridCell DownRight() const {
 			assert(!IsBottomRow() && !IsRightColumn());
-			return  parentGrid[Coordinate(x + 1, y - 1)];
+			return BasicGridCell{ x + 1, y - 1, *parentGrid };
 		}
-		GridCell UpLeft() const {
+		BasicGridCell UpLeft() const {
 			assert(!IsTopRow() && !IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y + 1)];
+			return BasicGridCell{ x - 1, y + 1, *parentGrid };
 		}
-		GridCell &UpLeft() {
-			assert(!IsTopRow() && !IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y + 1)];
-		}
-		GridCell DownLeft() const {
+		BasicGridCell DownLeft() const {
 			assert(!IsBottomRow() && !IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y - 1)];
-		}
-		GridCell &DownLeft() {
-			assert(!IsBottomRow() && !IsLeftColumn());
-			return  parentGrid[Coordinate(x - 1, y - 1)];
+			return BasicGridCell{ x - 1, y - 1, *parentGrid };
 		}
 
 		// Functions for returning the adjacent cells in a given cardinal direction.
@@ -173,181 +209,178 @@ namespace GridUtils
 		// to return the cell on the opposite end of the row or column (i.e. if requesting
 		// the cell to the right of the far right cell on a row, we will wrap around to
 		// return the cell on the far left of that row).
-		// Can either return the adjacent cell as read-only value (const version
-		// of the function) or read-write reference (non-const version of function);
-		GridCell UpOrWrap() const {
-			if (IsTopRow()) { return parentGrid[Coordinate(x, 0)]; }
-			else { return parentGrid[Coordinate(x, y + 1)]; }
-		}
-		GridCell& UpOrWrap() {
-			if (IsTopRow()) { return parentGrid[Coordinate(x, 0)]; }
-			else { return parentGrid[Coordinate(x, y + 1)]; }
-		}
-		GridCell DownOrWrap() const {
-			if (IsBottomRow()) { return parentGrid[Coordinate(x, parentGrid.Height() - 1)]; }
-			else { return parentGrid[Coordinate(x, y - 1)]; }
-		}
-		GridCell& DownOrWrap() {
-			if (IsBottomRow()) { return parentGrid[Coordinate(x, parentGrid.Height() - 1)]; }
-			else { return parentGrid[Coordinate(x, y - 1)]; }
-		}
-		GridCell RightOrWrap() const {
-			if (IsRightColumn()) { return parentGrid[Coordinate(0, y)]; }
-			else { return parentGrid[Coordinate(x + 1, y)]; }
+		BasicGridCell UpOrWrap() const {
+			return BasicGridCell{ x, IsTopRow() ? 0 : y + 1, *parentGrid };
 		}
-		GridCell& RightOrWrap() {
-			if (IsRightColumn()) { return parentGrid[Coordinate(0, y)]; }
-			else { return parentGrid[Coordinate(x + 1, y)]; }
+		BasicGridCell DownOrWrap() const {
+			return BasicGridCell{ x, IsBottomRow() ? parentGrid->height - 1 : y - 1, *parentGrid };
 		}
-		GridCell LeftOrWrap() const {
-			if (IsLeftColumn()) { return parentGrid[Coordinate(parentGrid.Width() - 1, y)]; }
-			else { return parentGrid[Coordinate(x - 1, y)]; }
+		BasicGridCell RightOrWrap() const {
+			return BasicGridCell{ IsRightColumn() ? 0 : x + 1, y, *parentGrid };
 		}
-		GridCell& LeftOrWrap() {
-			if (IsLeftColumn()) { return parentGrid[Coordinate(parentGrid.Width() - 1, y)]; }
-			else { return parentGrid[Coordinate(x - 1, y)]; }
+		BasicGridCell LeftOrWrap() const {
+			return BasicGridCell{ IsLeftColumn() ? parentGrid->width - 1 : x - 1, y, *parentGrid };
 		}
 
-		friend bool operator==(const GridCell& cell1, const GridCell& cell2)
+		friend bool operator==(const BasicGridCell& cell1, const BasicGridCell& cell2)
 		{
 			return cell1.GetCoordinate() == cell2.GetCoordinate();
 		}
-		friend bool operator!=(const GridCell& cell1, const GridCell& cell2)
+		friend bool operator!=(const BasicGridCell& cell1, const BasicGridCell& cell2)
 		{
 			return cell1.GetCoordinate() != cell2.GetCoordinate();
 		}
 	};
 
-	// We need to define the constructor for a Grid down here, since it requires knowledge
-	// of the GridCell constructor.
-	// Given a 2D-vector of values, create a new 2D-vector which wrap up each of those
-	// values in a GridCell.
+	// We need to define the constructors for a Grid down here, alongside the GridCell.
+	// Given a 2D-vector of values, lay each row out one after the other. Every row must be
+	// the same length.
 	template <typename T>
-	Grid<T>::Grid(std::vector<std::vector<T>> gridIn)
+	Grid<T>::Grid(std::vector<std::vector<T>> const& gridIn) :
+		Grid{ gridIn.empty() ? 0 : static_cast<unsigned int>(gridIn[0].size()), static_cast<unsigned int>(gridIn.size()) }
 	{
-		for (unsigned int row = 0; row < gridIn.size(); row++)
+		for (std::vector<T> const& lineIn : gridIn)
 		{
-			std::vector<GridCell> newLine{};
-			std::vector<T> lineIn = gridIn[row];
-			for (unsigned int column = 0; column < lineIn.size(); column++)
-			{
-				newLine.push_back(GridCell{column, row, *this, lineIn[column]});
-			}
-			grid.push_back(newLine);
+			assert(lineIn.size() == width);
+			values.insert(values.end(), lineIn.begin(), lineIn.end());
 		}
 	}
 
+	// As above, but the 2D-vector is finished with, so its values can be moved across.
+	template <typename T>
+	Grid<T>::Grid(std::vector<std::vector<T>>&& gridIn) :
+		Grid{ gridIn.empty() ? 0 : static_cast<unsigned int>(gridIn[0].size()), static_cast<unsigned int>(gridIn.size()) }
+	{
+		for (std::vector<T>& lineIn : gridIn)
+		{
+			assert(lineIn.size() == width);
+			values.insert(values.end(), std::make_move_iterator(lineIn.begin()), std::make_move_iterator(lineIn.end()));
+		}
+	}
+
+	// Given a row-major block of values, the grid can just take them as they are, starting
+	// a new row every width values.
+	template <typename T>
+	Grid<T>::Grid(std::vector<T> rowMajorValues, unsigned int width) :
+		values{ std::move(rowMajorValues) }, width{ width }
+	{
+		assert((width > 0) && ((values.size() % width) == 0));
+		height = values.size() / width;
+	}
+
+	template <typename T>
+	Grid<T>::Grid(unsigned int width, unsigned int height, T const& initialValue) :
+		values(static_cast<std::size_t>(width) * height, initialValue), width{ width }, height{ height }
+	{
+	}
+
+	template <typename T>
+	typename Grid<T>::GridCell Grid<T>::operator[] (Coordinate const& coord)
+	{
+		return GridCell{ coord.xPos, coord.yPos, *this };
+	}
+
+	template <typename T>
+	typename Grid<T>::ConstGridCell Grid<T>::operator[] (Coordinate const& coord) const
+	{
+		return ConstGridCell{ coord.xPos, coord.yPos, *this };
+	}
+
 	// Turn a 2D-vector of one type into a Grid of another, by applying a function to each
 	// element in the input grid. Useful for puzzles where we might have a grid of integers
 	// as input, but want to use a user-defined class to actually represent each element
 	// in that Grid.
-	// We accomplish this by creating a new 2D-vector by calling the cell constructor function
-	// on each element of the original 2D-vector, and then pass this 2D-vector into the
-	// regular Grid constructor to wrap it up as a Grid like usual.
+	// Space for every cell is reserved up front, and each transformed value is constructed
+	// straight into the new grid's storage, so the whole build is a single pass over the
+	// input.
 	template <typename T>
-	template <typename TypeIn>
-	Grid<T> Grid<T>::GridFactory(std::vector<std::vector<TypeIn>> gridIn, T(* cellConstructor)(TypeIn))
+	template <typename TypeIn, typename CellConstructor>
+	Grid<T> Grid<T>::GridFactory(std::vector<std::vector<TypeIn>> const& gridIn, CellConstructor cellConstructor)
 	{
-		std::vector<std::vector<T>> transformedGrid;
-		for (std::vector<TypeIn> rowIn : gridIn)
+		Grid newGrid{ gridIn.empty() ? 0 : static_cast<unsigned int>(gridIn[0].size()), static_cast<unsigned int>(gridIn.size()) };
+		for (std::vector<TypeIn> const& rowIn : gridIn)
 		{
-			std::vector<T> newLine{};
-			for (TypeIn cellIn : rowIn)
+			assert(rowIn.size() == newGrid.width);
+			for (TypeIn const& cellIn : rowIn)
 			{
-				newLine.push_back(cellConstructor(cellIn));
+				newGrid.values.emplace_back(cellConstructor(cellIn));
 			}
-			transformedGrid.push_back(newLine);
 		}
-		return Grid{transformedGrid};
+		return newGrid;
 	}
 
-	// Iterator for the Grid class. Holds a pointer to a GridCell. Incrementing
-	// the iterator will either:
-	//  - Move it to the next element on the same row of the grid if we're not
-	//    the end of a row already.
-	//  - Otherwise, move it to the first element in the next row, if we're not
-	//    also on the last row of the grid.
-	//  - Otherwise, set the GridCell pointer to nullptr, since we have been
-	//    iterated off the end of the Grid and should no longer be accessed.
+	// As above, but from a row-major block of values.
+	template <typename T>
+	template <typename TypeIn, typename CellConstructor>
+	Grid<T> Grid<T>::GridFactory(std::vector<TypeIn> const& rowMajorValuesIn, unsigned int width, CellConstructor cellConstructor)
+	{
+		assert((width > 0) && ((rowMajorValuesIn.size() % width) == 0));
+		Grid newGrid{ width, static_cast<unsigned int>(rowMajorValuesIn.size() / width) };
+		for (TypeIn const& cellIn : rowMajorValuesIn)
+		{
+			newGrid.values.emplace_back(cellConstructor(cellIn));
+		}
+		return newGrid;
+	}
+
+	// Iterator for the Grid class. Since the values are stored row by row, iterating
+	// through the grid is just a walk along the row-major index, starting from the origin
+	// and finishing once every row has been visited.
 	template <typename T>
 	class Grid<T>::Iterator
 	{
 	private:
-		Grid &grid;
-		GridCell *cellPtr;
+		Grid *grid;
+		std::size_t index;
 
-		// Move to point to the next element in the grid, whether that be the
-		// next element in the current row, the first element in the next row,
-		// or just nullptr if we're out of grid to iterate over.
-		void IncrementCell()
+		// Lets operator-> hand out a pointer to a GridCell, which only exists for as long as
+		// the expression it's used in.
+		struct CellPointer
 		{
-			assert(cellPtr != nullptr);
-			Coordinate newCoord = cellPtr->GetCoordinate();
-			if (cellPtr->IsRightColumn())
-			{
-				if (cellPtr->IsTopRow())
-				{
-					cellPtr = nullptr;
-					return;
-				}
-				else
-				{
-					newCoord.xPos = 0;
-					newCoord.yPos++;
-				}
-			}
-			else
-			{
-				newCoord.xPos++;
-			}
-			cellPtr = &grid[newCoord];
-		}
+			GridCell cell;
+			GridCell* operator->() { return &cell; }
+		};
 	public:
 		// An Iterator can be constructed from a Grid reference to point to
 		// the cells within, and coordinate to start the iteration from.
-		// Constructing without a coordinate will create an Iterator with a
-		// nullptr, which should be used to create the end iterator.
-		Iterator(Grid &gridIn, Coordinate coord) : grid { gridIn }
-		{
-			cellPtr = &grid[coord];
-		}
-		Iterator(Grid& gridIn) : grid{ gridIn }
+		// Constructing without a coordinate will create an Iterator that is
+		// one past the last cell, which should be used to create the end iterator.
+		Iterator(Grid &gridIn, Coordinate coord) : grid{ &gridIn }, index{ gridIn.IndexOf(coord.xPos, coord.yPos) } {}
+		Iterator(Grid& gridIn) : grid{ &gridIn }, index{ gridIn.values.size() } {}
+
+		GridCell operator*() const
 		{
-			cellPtr = nullptr;
+			return GridCell{ static_cast<unsigned int>(index % grid->width), static_cast<unsigned int>(index / grid->width), *grid };
 		}
-
-		GridCell& operator*() { return *cellPtr; }
-		GridCell* operator->() { return cellPtr; }
+		CellPointer operator->() const { return CellPointer{ **this }; }
 
 		// Pre- and post-fix increments.
 		Iterator& operator++() { 
-			IncrementCell();
+			index++;
 			return *this;
 		}
 		Iterator operator++(int)
 		{
 			Iterator tempItr = *this;
-			IncrementCell();
+			index++;
 			return tempItr;
 		}
 
 		friend bool operator==(const Iterator &itr1, const Iterator &itr2)
 		{
-			return (itr1.cellPtr == itr2.cellPtr);
+			return (itr1.grid == itr2.grid) && (itr1.index == itr2.index);
 		}
 		friend bool operator!=(const Iterator &itr1, const Iterator &itr2)
 		{
-			return (itr1.cellPtr != itr2.cellPtr);
+			return !(itr1 == itr2);
 		}
 	};
 
 	// Begin and End iterators for iterating over a grid.
 	// The Begin iterator starts at the origin of the grid. The End iterator
-	// is constructed without passing in a coordinate, which causes the Iterator
-	// class to construct itself to have a null pointer rather than pointer to
-	// a valid GridCell, in the same way that it will set its pointer to
-	// nullptr when it detects that it is being iterated out of the bounds
-	// of the Grid.
+	// is constructed without passing in a coordinate, which places it one past
+	// the last cell of the top row, where iterating off the end of the grid
+	// will also leave an iterator.
 	template <typename T>
 	typename Grid<T>::Iterator Grid<T>::begin()
 	{
@@ -358,4 +391,845 @@ namespace GridUtils
 	{
 		return Iterator{ *this };
 	}
+
+	// A grid of single bits packed into 64-bit words, for puzzles where each cell is just on
+	// or off. Each row starts on a fresh word, with cells at increasing x held in increasing
+	// bit positions, so a whole row can be worked on a word at a time: shifting a row moves every
+	// cell along at once, and rows can be OR'd or AND'd together 64 bits per instruction.
+	// Any bits past the end of a row are always kept clear, so that whole-word operations
+	// never have to special case the last word.
+	class BitGrid
+	{
+	public:
+		static constexpr unsigned int bitsPerWord{ 64 };
+		static constexpr unsigned int cellsPerWord{ bitsPerWord };
+		static constexpr std::uint64_t cellMask{ 1 };
+
+	private:
+		std::vector<std::uint64_t> words{};
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+		unsigned int wordsPerRow{ 0 };
+
+		// A word with the given cell value repeated in every cell.
+		static constexpr std::uint64_t Replicate(unsigned int cellValue)
+		{
+			return cellValue ? ~std::uint64_t{ 0 } : 0;
+		}
+
+		// Reverse the order of the bits in a word, by swapping neighbouring bits, then pairs
+		// of bits, and so on up to the two halves of the word.
+		static constexpr std::uint64_t ReverseBits(std::uint64_t word)
+		{
+			word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+			word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+			word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+			word = ((word >> 8) & 0x00FF00FF00FF00FFULL) | ((word & 0x00FF00FF00FF00FFULL) << 8);
+			word = ((word >> 16) & 0x0000FFFF0000FFFFULL) | ((word & 0x0000FFFF0000FFFFULL) << 16);
+			return (word >> 32) | (word << 32);
+		}
+
+		// Which bits of the last word in a row actually belong to cells of that row.
+		std::uint64_t LastWordMask() const
+		{
+			unsigned int usedBits = (width - 1) % cellsPerWord + 1;
+			return (usedBits == bitsPerWord) ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << usedBits) - 1);
+		}
+
+	public:
+		BitGrid() = default;
+		BitGrid(unsigned int widthIn, unsigned int heightIn, unsigned int initialValue = 0) :
+			width{ widthIn }, height{ heightIn }, wordsPerRow{ (widthIn + cellsPerWord - 1) / cellsPerWord }
+		{
+			assert(initialValue <= cellMask);
+			words.assign(static_cast<std::size_t>(wordsPerRow) * height, Replicate(initialValue));
+			if ((initialValue != 0) && (wordsPerRow > 0))
+			{
+				for (unsigned int y = 0; y < height; y++) { Row(y).back() &= LastWordMask(); }
+			}
+		}
+
+		unsigned int Width() const { return width; }
+		unsigned int Height() const { return height; }
+		unsigned int WordsPerRow() const { return wordsPerRow; }
+
+		// How much memory the cells of a grid of the given size take up.
+		static std::size_t StorageBytes(unsigned int gridWidth, unsigned int gridHeight)
+		{
+			return static_cast<std::size_t>((gridWidth + cellsPerWord - 1) / cellsPerWord) * gridHeight * sizeof(std::uint64_t);
+		}
+
+		unsigned int Get(Coordinate const& coord) const
+		{
+			assert((coord.xPos < width) && (coord.yPos < height));
+			std::uint64_t word = words[(static_cast<std::size_t>(coord.yPos) * wordsPerRow) + (coord.xPos / cellsPerWord)];
+			return static_cast<unsigned int>((word >> (coord.xPos % cellsPerWord)) & cellMask);
+		}
+		void Set(Coordinate const& coord, unsigned int cellValue)
+		{
+			assert((coord.xPos < width) && (coord.yPos < height) && (cellValue <= cellMask));
+			std::uint64_t& word = words[(static_cast<std::size_t>(coord.yPos) * wordsPerRow) + (coord.xPos / cellsPerWord)];
+			unsigned int shift = coord.xPos % cellsPerWord;
+			word = (word & ~(cellMask << shift)) | (static_cast<std::uint64_t>(cellValue) << shift);
+		}
+
+		// The packed words making up a single row.
+		std::span<std::uint64_t> Row(unsigned int y)
+		{
+			assert(y < height);
+			return { words.data() + (static_cast<std::size_t>(y) * wordsPerRow), wordsPerRow };
+		}
+		std::span<std::uint64_t const> Row(unsigned int y) const
+		{
+			assert(y < height);
+			return { words.data() + (static_cast<std::size_t>(y) * wordsPerRow), wordsPerRow };
+		}
+
+		// Overwrite a row with, or combine it with, a row of the same width from this or
+		// another grid.
+		void CopyRow(unsigned int y, std::span<std::uint64_t const> otherRow)
+		{
+			assert(otherRow.size() == wordsPerRow);
+			std::copy(otherRow.begin(), otherRow.end(), Row(y).begin());
+		}
+		void OrRow(unsigned int y, std::span<std::uint64_t const> otherRow)
+		{
+			assert(otherRow.size() == wordsPerRow);
+			std::span<std::uint64_t> row = Row(y);
+			for (unsigned int word = 0; word < wordsPerRow; word++) { row[word] |= otherRow[word]; }
+		}
+		void AndRow(unsigned int y, std::span<std::uint64_t const> otherRow)
+		{
+			assert(otherRow.size() == wordsPerRow);
+			std::span<std::uint64_t> row = Row(y);
+			for (unsigned int word = 0; word < wordsPerRow; word++) { row[word] &= otherRow[word]; }
+		}
+		void XorRow(unsigned int y, std::span<std::uint64_t const> otherRow)
+		{
+			assert(otherRow.size() == wordsPerRow);
+			std::span<std::uint64_t> row = Row(y);
+			for (unsigned int word = 0; word < wordsPerRow; word++) { row[word] ^= otherRow[word]; }
+		}
+
+		// Move every cell of a row along by a number of cells, towards higher x for a positive
+		// shift and lower x for a negative one. Cells shifted past either end of the row are
+		// lost, and cells shifted in are zero.
+		void ShiftRow(unsigned int y, int cellShift)
+		{
+			std::span<std::uint64_t> row = Row(y);
+			unsigned int bitShift = static_cast<unsigned int>((cellShift < 0) ? -cellShift : cellShift);
+			unsigned int wordShift = bitShift / bitsPerWord;
+			bitShift %= bitsPerWord;
+			if (cellShift > 0)
+			{
+				for (unsigned int word = wordsPerRow; word-- > 0;)
+				{
+					std::uint64_t shifted{ 0 };
+					if (word >= wordShift)
+					{
+						shifted = row[word - wordShift] << bitShift;
+						if ((bitShift != 0) && (word > wordShift)) { shifted |= row[word - wordShift - 1] >> (bitsPerWord - bitShift); }
+					}
+					row[word] = shifted;
+				}
+				if (wordsPerRow > 0) { row.back() &= LastWordMask(); }
+			}
+			else if (cellShift < 0)
+			{
+				for (unsigned int word = 0; word < wordsPerRow; word++)
+				{
+					std::uint64_t shifted{ 0 };
+					if ((word + wordShift) < wordsPerRow)
+					{
+						shifted = row[word + wordShift] >> bitShift;
+						if ((bitShift != 0) && ((word + wordShift + 1) < wordsPerRow)) { shifted |= row[word + wordShift + 1] << (bitsPerWord - bitShift); }
+					}
+					row[word] = shifted;
+				}
+			}
+		}
+
+		// As ShiftRow, but cells shifted past one end of the row come back in at the other,
+		// for grids that wrap around. The shift must be shorter than both the row and a single
+		// word, which lets the cells that wrap round be carried over in one word.
+		void RotateRow(unsigned int y, int cellShift)
+		{
+			unsigned int wrappingCells = static_cast<unsigned int>((cellShift < 0) ? -cellShift : cellShift);
+			assert((wrappingCells < width) && (wrappingCells < cellsPerWord));
+			std::uint64_t wrapped{ 0 };
+			if (cellShift > 0)
+			{
+				for (unsigned int cell = 0; cell < wrappingCells; cell++)
+				{
+					wrapped |= static_cast<std::uint64_t>(Get({ width - wrappingCells + cell, y })) << cell;
+				}
+				ShiftRow(y, cellShift);
+				Row(y).front() |= wrapped;
+			}
+			else if (cellShift < 0)
+			{
+				wrapped = Row(y).front();
+				ShiftRow(y, cellShift);
+				for (unsigned int cell = 0; cell < wrappingCells; cell++)
+				{
+					Set({ width - wrappingCells + cell, y }, static_cast<unsigned int>((wrapped >> cell) & cellMask));
+				}
+			}
+		}
+
+		// Reverse the order of the cells in a row, so that the cell at x ends up at
+		// (width - 1 - x). Reversing the order of the words and the bits within each word
+		// leaves the row's unused bits at the bottom of the first word, so the row is then
+		// shifted down by that many cells to put the cells back at the start of the row.
+		void ReverseRow(unsigned int y)
+		{
+			std::span<std::uint64_t> row = Row(y);
+			std::reverse(row.begin(), row.end());
+			for (std::uint64_t& word : row) { word = ReverseBits(word); }
+			ShiftRow(y, -static_cast<int>((wordsPerRow * cellsPerWord) - width));
+		}
+
+		// Change the size of the grid, keeping the values of any cells that are in both the old
+		// and new grid, and zeroing any new cells.
+		void Resize(unsigned int newWidth, unsigned int newHeight)
+		{
+			BitGrid resizedGrid{ newWidth, newHeight };
+			unsigned int rowsToKeep = (newHeight < height) ? newHeight : height;
+			unsigned int wordsToKeep = (resizedGrid.wordsPerRow < wordsPerRow) ? resizedGrid.wordsPerRow : wordsPerRow;
+			for (unsigned int y = 0; y < rowsToKeep; y++)
+			{
+				std::span<std::uint64_t const> oldRow = Row(y);
+				std::span<std::uint64_t> newRow = resizedGrid.Row(y);
+				for (unsigned int word = 0; word < wordsToKeep; word++) { newRow[word] = oldRow[word]; }
+				if (newWidth < width) { newRow.back() &= resizedGrid.LastWordMask(); }
+			}
+			*this = std::move(resizedGrid);
+		}
+
+		// How many cells hold the given value, found a word at a time by marking each cell that
+		// matches and counting the marks.
+		ULLINT Count(unsigned int cellValue = 1) const
+		{
+			assert(cellValue <= cellMask);
+			if (wordsPerRow == 0) { return 0; }
+			std::uint64_t const pattern = Replicate(cellValue);
+			std::uint64_t const lastWordMask = LastWordMask();
+			ULLINT count{ 0 };
+			for (unsigned int y = 0; y < height; y++)
+			{
+				std::span<std::uint64_t const> row = Row(y);
+				for (unsigned int word = 0; word < wordsPerRow; word++)
+				{
+					std::uint64_t matchingBits = ~(row[word] ^ pattern);
+					if (word == (wordsPerRow - 1)) { matchingBits &= lastWordMask; }
+					count += std::popcount(matchingBits);
+				}
+			}
+			return count;
+		}
+	};
+
+	// A grid surrounded by a halo of cells on every side, a single layer deep unless asked
+	// otherwise. The halo holds a fixed value standing in for whatever lies beyond the edges
+	// of the grid, so code visiting the neighbours of a cell never has to check whether it's
+	// on an edge. Rows are stored one after the other, halo included, so the cells above and
+	// below any cell are always exactly one stride away.
+	// A deeper halo leaves room for the grid to grow: GrowIntoHalo takes layers of the halo
+	// into the grid itself without moving any cells, for puzzles where the interesting
+	// region spreads outwards a little every step.
+	template <typename T>
+	class PaddedGrid
+	{
+	private:
+		std::vector<T> cells{};
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+		unsigned int haloWidth{ 1 };
+		std::size_t stride{ 0 };
+
+	public:
+		PaddedGrid() = default;
+		PaddedGrid(unsigned int widthIn, unsigned int heightIn, T const& haloValue, unsigned int haloWidthIn = 1) :
+			cells((static_cast<std::size_t>(widthIn) + (2 * haloWidthIn)) * (static_cast<std::size_t>(heightIn) + (2 * haloWidthIn)), haloValue),
+			width{ widthIn }, height{ heightIn }, haloWidth{ haloWidthIn },
+			stride{ static_cast<std::size_t>(widthIn) + (2 * haloWidthIn) }
+		{
+			assert(haloWidth >= 1);
+		}
+
+		// Copy a row-major block of values, or the values of a Grid, into the middle of a new
+		// padded grid.
+		PaddedGrid(std::vector<T> const& rowMajorValues, unsigned int widthIn, T const& haloValue, unsigned int haloWidthIn = 1) :
+			PaddedGrid{ widthIn, static_cast<unsigned int>(rowMajorValues.size() / widthIn), haloValue, haloWidthIn }
+		{
+			assert((rowMajorValues.size() % width) == 0);
+			for (unsigned int y = 0; y < height; y++)
+			{
+				std::copy_n(rowMajorValues.begin() + (static_cast<std::size_t>(y) * width), width, Row(y));
+			}
+		}
+		PaddedGrid(Grid<T> const& grid, T const& haloValue, unsigned int haloWidthIn = 1) :
+			PaddedGrid{ grid.Values(), grid.Width(), haloValue, haloWidthIn } {}
+
+		unsigned int Width() const { return width; }
+		unsigned int Height() const { return height; }
+		unsigned int HaloWidth() const { return haloWidth; }
+
+		// How far apart the starts of two consecutive rows are.
+		std::size_t Stride() const { return stride; }
+
+		// A pointer to the first (non-halo) cell of a row. The halo cells either side of the
+		// row are at [-1] and [Width()], and the rows above and below are at +/- Stride().
+		T* Row(unsigned int y)
+		{
+			assert(y < height);
+			return cells.data() + ((static_cast<std::size_t>(y) + haloWidth) * stride) + haloWidth;
+		}
+		T const* Row(unsigned int y) const
+		{
+			assert(y < height);
+			return cells.data() + ((static_cast<std::size_t>(y) + haloWidth) * stride) + haloWidth;
+		}
+
+		T& operator[] (Coordinate const& coord) { return Row(coord.yPos)[coord.xPos]; }
+		T const& operator[] (Coordinate const& coord) const { return Row(coord.yPos)[coord.xPos]; }
+
+		// Set every halo cell to a new value.
+		void FillHalo(T const& haloValue)
+		{
+			std::size_t const haloRowsSize = stride * haloWidth;
+			std::fill_n(cells.begin(), haloRowsSize, haloValue);
+			std::fill_n(cells.end() - haloRowsSize, haloRowsSize, haloValue);
+			for (unsigned int y = 0; y < height; y++)
+			{
+				std::fill_n(Row(y) - haloWidth, haloWidth, haloValue);
+				std::fill_n(Row(y) + width, haloWidth, haloValue);
+			}
+		}
+
+		// Make sure the halo is at least a given number of cells deep, moving the grid into a
+		// bigger block if it isn't. Any new halo cells are set to haloValue.
+		void ReserveHalo(unsigned int newHaloWidth, T const& haloValue)
+		{
+			if (newHaloWidth <= haloWidth) { return; }
+			PaddedGrid widerGrid{ width, height, haloValue, newHaloWidth };
+			for (unsigned int y = 0; y < height; y++)
+			{
+				std::copy_n(Row(y) - haloWidth, width + (2 * haloWidth), widerGrid.Row(y) - haloWidth);
+			}
+			for (unsigned int layer = 1; layer <= haloWidth; layer++)
+			{
+				std::copy_n(Row(0) - (layer * stride) - haloWidth, width + (2 * haloWidth), widerGrid.Row(0) - (layer * widerGrid.stride) - haloWidth);
+				std::copy_n(Row(height - 1) + (layer * stride) - haloWidth, width + (2 * haloWidth), widerGrid.Row(height - 1) + (layer * widerGrid.stride) - haloWidth);
+			}
+			*this = std::move(widerGrid);
+		}
+
+		// Grow the grid by a number of cells on every side, taking them from the halo. The
+		// cells the grid grows into keep whatever value they had in the halo, so a grid whose
+		// halo holds the value of everything beyond its edges grows without changing what it
+		// represents. At least one layer of halo is always left, and if there isn't enough
+		// halo for that the halo is first made deeper, doubling in depth each time so that a
+		// grid growing a cell at a time only rarely has to move.
+		void GrowIntoHalo(unsigned int cellsPerSide, T const& haloValue)
+		{
+			if (haloWidth <= cellsPerSide)
+			{
+				ReserveHalo(std::max(cellsPerSide + 1, 2 * haloWidth), haloValue);
+			}
+			haloWidth -= cellsPerSide;
+			width += 2 * cellsPerSide;
+			height += 2 * cellsPerSide;
+		}
+	};
+
+	// A pair of grids of the same size for step by step simulations where every cell of the
+	// next step is worked out from the cells of the step before, e.g.
+	//     ApplyStencil(grids.Current(), grids.Next(), kernel);
+	//     grids.Swap();
+	// Both grids are made up front, and swapping just changes which of them is current, so
+	// stepping the simulation never allocates or copies a grid. Anything in the next grid
+	// that the step doesn't write (the halo of a PaddedGrid, say) is left over from two steps
+	// before.
+	template <typename GridType>
+	class DoubleBufferedGrid
+	{
+	private:
+		std::array<GridType, 2> buffers{};
+		unsigned int currentBuffer{ 0 };
+
+	public:
+		DoubleBufferedGrid() = default;
+		explicit DoubleBufferedGrid(GridType const& initialGrid) : buffers{ initialGrid, initialGrid } {}
+
+		GridType& Current() { return buffers[currentBuffer]; }
+		GridType const& Current() const { return buffers[currentBuffer]; }
+		GridType& Next() { return buffers[currentBuffer ^ 1]; }
+		GridType const& Next() const { return buffers[currentBuffer ^ 1]; }
+
+		// Make the next grid the current one, and the old current grid free to be written
+		// over as the next step.
+		void Swap() { currentBuffer ^= 1; }
+	};
+
+	// Stencils visit a 3x3 window of cells centred on each cell of a grid in turn. Kernels can
+	// look at the 4 neighbours in the cardinal directions, or all 8 neighbours.
+	enum class Neighbourhood
+	{
+		FourNeighbours,
+		EightNeighbours
+	};
+
+	// The 3x3 window of cells around a single cell of a PaddedGrid, as seen by a stencil
+	// kernel. Up is towards higher y, as with GridCell.
+	template <typename T>
+	struct StencilWindow
+	{
+		T const* below;
+		T const* centre;
+		T const* above;
+
+		T const& Centre() const { return centre[0]; }
+		T const& Up() const { return above[0]; }
+		T const& Down() const { return below[0]; }
+		T const& Left() const { return centre[-1]; }
+		T const& Right() const { return centre[1]; }
+		T const& UpLeft() const { return above[-1]; }
+		T const& UpRight() const { return above[1]; }
+		T const& DownLeft() const { return below[-1]; }
+		T const& DownRight() const { return below[1]; }
+	};
+
+	// Split the rows of a grid into bands and run bandWork(firstRow, endRow) on each band, the
+	// first on the calling thread and the rest on threads of their own, returning once every
+	// band is done. Bands never share a row, so work that only writes to the rows of its own
+	// band needs no further synchronisation.
+	template <typename BandWork>
+	void ForEachRowBand(unsigned int height, unsigned int numberOfBands, BandWork bandWork)
+	{
+		numberOfBands = std::clamp(numberOfBands, 1u, std::max(height, 1u));
+		auto bandStart = [height, numberOfBands](unsigned int band)
+		{
+			return static_cast<unsigned int>((static_cast<ULLINT>(height) * band) / numberOfBands);
+		};
+
+		std::vector<std::future<void>> laterBands{};
+		for (unsigned int band = 1; band < numberOfBands; band++)
+		{
+			laterBands.push_back(std::async(std::launch::async, bandWork, bandStart(band), bandStart(band + 1)));
+		}
+		bandWork(bandStart(0), bandStart(1));
+		for (std::future<void>& laterBand : laterBands)
+		{
+			laterBand.get();
+		}
+	}
+
+	// Apply a kernel to the 3x3 window around every cell of a padded grid, writing what it
+	// returns to the same cell of another grid of the same size, e.g.
+	//     ApplyStencil(heights, isLowest, [](StencilWindow<int> const& w) { return w.Centre() < w.Up(); });
+	// The kernel is inlined into a plain loop along each row, with the neighbouring rows read
+	// through pointers and no edge checks, so simple branch-free kernels are left for the
+	// compiler to vectorise. Rows can be split into bands processed on separate threads, in
+	// which case the kernel must be safe to call from several threads at once.
+	template <typename T, typename TOut, typename Kernel>
+	void ApplyStencil(PaddedGrid<T> const& source, PaddedGrid<TOut>& destination, Kernel kernel, unsigned int rowBands = 1)
+	{
+		assert((source.Width() == destination.Width()) && (source.Height() == destination.Height()));
+		ForEachRowBand(source.Height(), rowBands, [&source, &destination, &kernel](unsigned int firstRow, unsigned int endRow)
+			{
+				std::size_t const stride = source.Stride();
+				unsigned int const width = source.Width();
+				for (unsigned int y = firstRow; y < endRow; y++)
+				{
+					T const* centreRow = source.Row(y);
+					TOut* outputRow = destination.Row(y);
+					for (unsigned int x = 0; x < width; x++)
+					{
+						outputRow[x] = kernel(StencilWindow<T>{ centreRow + x - stride, centreRow + x, centreRow + x + stride });
+					}
+				}
+			});
+	}
+
+	// A grid split into square tiles, TileSize cells along each side, with the cells of each
+	// tile held together in one row-major block. Work that stays inside a tile only ever
+	// touches a few kB of memory, which stays in cache while the tile is being worked on,
+	// and separate tiles can be handed to separate threads. Tiles along the right and top
+	// edges of the grid may be cut short, but still take up a full tile of storage.
+	// Tiles are numbered row by row from the origin, the same as the cells of a Grid.
+	template <typename T, unsigned int TileSize = 64>
+	class TiledGrid
+	{
+	public:
+		static constexpr unsigned int tileSize{ TileSize };
+		static constexpr std::size_t cellsPerTile{ static_cast<std::size_t>(TileSize) * TileSize };
+
+		// A view onto a single tile. Cells are looked up by their coordinates within the tile,
+		// with Origin() giving the coordinate of the tile's own origin within the grid.
+		template <typename CellType>
+		class TileView
+		{
+		private:
+			CellType* cells;
+			Coordinate origin;
+			unsigned int width;
+			unsigned int height;
+			unsigned int index;
+
+		public:
+			TileView(CellType* cellsIn, Coordinate originIn, unsigned int widthIn, unsigned int heightIn, unsigned int indexIn) :
+				cells{ cellsIn }, origin{ originIn }, width{ widthIn }, height{ heightIn }, index{ indexIn } {}
+
+			Coordinate Origin() const { return origin; }
+			unsigned int Width() const { return width; }
+			unsigned int Height() const { return height; }
+			unsigned int Index() const { return index; }
+
+			// A pointer to the first cell of a row of the tile. Rows of a tile are always
+			// TileSize cells apart, even when the tile has been cut short.
+			CellType* Row(unsigned int localY) const
+			{
+				assert(localY < height);
+				return cells + (static_cast<std::size_t>(localY) * TileSize);
+			}
+			CellType& operator[] (Coordinate const& localCoord) const
+			{
+				assert(localCoord.xPos < width);
+				return Row(localCoord.yPos)[localCoord.xPos];
+			}
+		};
+		using Tile = TileView<T>;
+		using ConstTile = TileView<T const>;
+
+	private:
+		std::vector<T> cells{};
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+		unsigned int tilesWide{ 0 };
+		unsigned int tilesHigh{ 0 };
+
+		std::size_t IndexOf(unsigned int x, unsigned int y) const
+		{
+			assert((x < width) && (y < height));
+			std::size_t tileIndex = (static_cast<std::size_t>(y / TileSize) * tilesWide) + (x / TileSize);
+			return (tileIndex * cellsPerTile) + (static_cast<std::size_t>(y % TileSize) * TileSize) + (x % TileSize);
+		}
+
+		// Tiles are handed out by the range below as well as by index, which both need to work
+		// out where a tile starts and how much of it is used.
+		template <typename CellType>
+		static TileView<CellType> MakeTile(CellType* cellsIn, unsigned int gridWidth, unsigned int gridHeight, unsigned int tilesAcross, unsigned int tileIndex)
+		{
+			Coordinate origin{ (tileIndex % tilesAcross) * TileSize, (tileIndex / tilesAcross) * TileSize };
+			return TileView<CellType>{ cellsIn + (tileIndex * cellsPerTile), origin,
+				std::min(TileSize, gridWidth - origin.xPos), std::min(TileSize, gridHeight - origin.yPos), tileIndex };
+		}
+
+	public:
+		TiledGrid() = default;
+		TiledGrid(unsigned int widthIn, unsigned int heightIn, T const& initialValue) :
+			width{ widthIn }, height{ heightIn },
+			tilesWide{ (widthIn + TileSize - 1) / TileSize }, tilesHigh{ (heightIn + TileSize - 1) / TileSize }
+		{
+			cells.assign(static_cast<std::size_t>(tilesWide) * tilesHigh * cellsPerTile, initialValue);
+		}
+
+		// Copy the values of a Grid into tiles, a row of a tile at a time.
+		TiledGrid(Grid<T> const& grid, T const& fillValue = T{}) : TiledGrid{ grid.Width(), grid.Height(), fillValue }
+		{
+			for (unsigned int y = 0; y < height; y++)
+			{
+				for (unsigned int tileX = 0; tileX < width; tileX += TileSize)
+				{
+					std::copy_n(grid.Values().begin() + ((static_cast<std::size_t>(y) * width) + tileX),
+						std::min(TileSize, width - tileX), cells.begin() + IndexOf(tileX, y));
+				}
+			}
+		}
+
+		unsigned int Width() const { return width; }
+		unsigned int Height() const { return height; }
+		unsigned int TilesWide() const { return tilesWide; }
+		unsigned int TilesHigh() const { return tilesHigh; }
+		unsigned int NumberOfTiles() const { return tilesWide * tilesHigh; }
+
+		T& operator[] (Coordinate const& coord) { return cells[IndexOf(coord.xPos, coord.yPos)]; }
+		T const& operator[] (Coordinate const& coord) const { return cells[IndexOf(coord.xPos, coord.yPos)]; }
+
+		Tile GetTile(unsigned int tileIndex)
+		{
+			assert(tileIndex < NumberOfTiles());
+			return MakeTile(cells.data(), width, height, tilesWide, tileIndex);
+		}
+		ConstTile GetTile(unsigned int tileIndex) const
+		{
+			assert(tileIndex < NumberOfTiles());
+			return MakeTile(cells.data(), width, height, tilesWide, tileIndex);
+		}
+
+		// A range over every tile of the grid, for use in range-based for loops, e.g.
+		//     for (auto tile : grid.Tiles()) { ... }
+		template <typename CellType>
+		class TileRange
+		{
+		private:
+			CellType* cells;
+			unsigned int width;
+			unsigned int height;
+			unsigned int tilesWide;
+			unsigned int numberOfTiles;
+
+		public:
+			class Iterator
+			{
+			private:
+				TileRange const* range;
+				unsigned int tileIndex;
+			public:
+				Iterator(TileRange const* rangeIn, unsigned int tileIndexIn) : range{ rangeIn }, tileIndex{ tileIndexIn } {}
+				TileView<CellType> operator*() const
+				{
+					return MakeTile(range->cells, range->width, range->height, range->tilesWide, tileIndex);
+				}
+				Iterator& operator++()
+				{
+					tileIndex++;
+					return *this;
+				}
+				friend bool operator==(Iterator const& itr1, Iterator const& itr2) { return itr1.tileIndex == itr2.tileIndex; }
+				friend bool operator!=(Iterator const& itr1, Iterator const& itr2) { return !(itr1 == itr2); }
+			};
+
+			TileRange(CellType* cellsIn, unsigned int widthIn, unsigned int heightIn, unsigned int tilesWideIn, unsigned int numberOfTilesIn) :
+				cells{ cellsIn }, width{ widthIn }, height{ heightIn }, tilesWide{ tilesWideIn }, numberOfTiles{ numberOfTilesIn } {}
+			Iterator begin() const { return Iterator{ this, 0 }; }
+			Iterator end() const { return Iterator{ this, numberOfTiles }; }
+		};
+		TileRange<T> Tiles() { return TileRange<T>{ cells.data(), width, height, tilesWide, NumberOfTiles() }; }
+		TileRange<T const> Tiles() const { return TileRange<T const>{ cells.data(), width, height, tilesWide, NumberOfTiles() }; }
+
+		// Run tileWork(tile) on every tile, sharing the tiles out between a number of threads
+		// as ForEachRowBand does with rows. Each tile is only ever given to one thread, so work
+		// that only writes to cells of its own tile needs no further synchronisation.
+		template <typename TileWork>
+		void ForEachTile(TileWork tileWork, unsigned int numberOfThreads = 1)
+		{
+			ForEachRowBand(NumberOfTiles(), numberOfThreads, [this, &tileWork](unsigned int firstTile, unsigned int endTile)
+				{
+					for (unsigned int tileIndex = firstTile; tileIndex < endTile; tileIndex++) { tileWork(GetTile(tileIndex)); }
+				});
+		}
+		template <typename TileWork>
+		void ForEachTile(TileWork tileWork, unsigned int numberOfThreads = 1) const
+		{
+			ForEachRowBand(NumberOfTiles(), numberOfThreads, [this, &tileWork](unsigned int firstTile, unsigned int endTile)
+				{
+					for (unsigned int tileIndex = firstTile; tileIndex < endTile; tileIndex++) { tileWork(GetTile(tileIndex)); }
+				});
+		}
+	};
+
+	// A grid that only stores the cells that have actually been written to, for puzzles where
+	// the cells in use are few and far between, or the edges of the grid aren't known up
+	// front. Cells are held in an open addressing hash table keyed on the coordinate packed
+	// into 64 bits, so looking up a cell is a multiply and a short walk along a single block
+	// of memory, with no allocation per cell.
+	// Reading and writing cells looks the same as for a Grid, through grid[coord].value, and
+	// iterating over the grid visits every stored cell (in no particular order). Looking up a
+	// cell that isn't stored yet stores it with a default value, like std::unordered_map. Also
+	// like std::unordered_map, storing a new cell may move the others, so a cell shouldn't be
+	// held on to while others are added.
+	template <typename T>
+	class SparseGrid
+	{
+	private:
+		struct Slot
+		{
+			std::uint64_t key;
+			T value;
+		};
+		static constexpr std::uint64_t emptyKey{ ~std::uint64_t{ 0 } };
+		static constexpr std::size_t minimumSlots{ 16 };
+
+		std::vector<Slot> slots{};
+		std::size_t numberOfCells{ 0 };
+		unsigned int hashShift{ 64 };
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+
+		static std::uint64_t KeyOf(Coordinate const& coord)
+		{
+			assert((coord.xPos != UINT_MAX) || (coord.yPos != UINT_MAX));
+			return (static_cast<std::uint64_t>(coord.yPos) << 32) | coord.xPos;
+		}
+		static Coordinate CoordinateOf(std::uint64_t key)
+		{
+			return Coordinate{ static_cast<unsigned int>(key & 0xFFFFFFFF), static_cast<unsigned int>(key >> 32) };
+		}
+
+		// Fibonacci hashing: the top bits of the key multiplied by 2^64 / golden ratio are
+		// well spread out even for keys that only differ in their low bits.
+		std::size_t FirstSlotFor(std::uint64_t key) const
+		{
+			return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> hashShift);
+		}
+
+		// The slot holding a key, or the empty slot where it would go, found by probing the
+		// slots one after another from where the key hashes to.
+		std::size_t SlotFor(std::uint64_t key) const
+		{
+			std::size_t const slotMask = slots.size() - 1;
+			std::size_t slot = FirstSlotFor(key);
+			while ((slots[slot].key != key) && (slots[slot].key != emptyKey))
+			{
+				slot = (slot + 1) & slotMask;
+			}
+			return slot;
+		}
+
+		// Move every cell into a table with a new number of slots, which must be a power of 2.
+		void Rehash(std::size_t numberOfSlots)
+		{
+			std::vector<Slot> oldSlots = std::exchange(slots, std::vector<Slot>(numberOfSlots, Slot{ emptyKey, T{} }));
+			hashShift = 64 - static_cast<unsigned int>(std::countr_zero(numberOfSlots));
+			for (Slot& oldSlot : oldSlots)
+			{
+				if (oldSlot.key != emptyKey) { slots[SlotFor(oldSlot.key)] = std::move(oldSlot); }
+			}
+		}
+
+	public:
+		// The table is kept at most half full, so each stored cell takes up at most this many
+		// bytes once the table has grown to fit it.
+		static constexpr std::size_t bytesPerStoredCell{ 2 * sizeof(Slot) };
+
+		class GridCell
+		{
+		private:
+			Coordinate coord;
+		public:
+			T& value;
+
+			GridCell(Coordinate coordIn, T& valueIn) : coord{ coordIn }, value{ valueIn } {}
+			Coordinate GetCoordinate() const { return coord; }
+		};
+
+		// A sparse grid can be told roughly how many cells it'll need to store, to save
+		// growing the table while they're added.
+		SparseGrid(std::size_t expectedCells = 0)
+		{
+			Rehash(std::max(minimumSlots, std::bit_ceil(2 * expectedCells)));
+		}
+
+		// One past the largest x and y of any cell stored so far, which is the size a Grid
+		// would need to be to hold every stored cell.
+		unsigned int Width() const { return width; }
+		unsigned int Height() const { return height; }
+		std::size_t NumberOfCells() const { return numberOfCells; }
+
+		bool Contains(Coordinate const& coord) const
+		{
+			return slots[SlotFor(KeyOf(coord))].key != emptyKey;
+		}
+
+		// The value of a cell, or the default value if the cell isn't stored, without storing it.
+		T Get(Coordinate const& coord) const
+		{
+			Slot const& slot = slots[SlotFor(KeyOf(coord))];
+			return (slot.key != emptyKey) ? slot.value : T{};
+		}
+
+		GridCell operator[] (Coordinate const& coord)
+		{
+			std::uint64_t const key = KeyOf(coord);
+			std::size_t slot = SlotFor(key);
+			if (slots[slot].key == emptyKey)
+			{
+				if (2 * (numberOfCells + 1) > slots.size())
+				{
+					Rehash(2 * slots.size());
+					slot = SlotFor(key);
+				}
+				slots[slot].key = key;
+				numberOfCells++;
+				width = std::max(width, coord.xPos + 1);
+				height = std::max(height, coord.yPos + 1);
+			}
+			return GridCell{ coord, slots[slot].value };
+		}
+
+		// Remove every cell, but keep the table at its current size ready to be filled again.
+		void Clear()
+		{
+			std::fill(slots.begin(), slots.end(), Slot{ emptyKey, T{} });
+			numberOfCells = 0;
+			width = 0;
+			height = 0;
+		}
+
+		// Iterator over the stored cells, which just steps over the empty slots of the table.
+		class Iterator
+		{
+		private:
+			SparseGrid* grid;
+			std::size_t slot;
+
+			void SkipEmptySlots()
+			{
+				while ((slot < grid->slots.size()) && (grid->slots[slot].key == emptyKey)) { slot++; }
+			}
+		public:
+			Iterator(SparseGrid& gridIn, std::size_t slotIn) : grid{ &gridIn }, slot{ slotIn } { SkipEmptySlots(); }
+
+			GridCell operator*() const
+			{
+				return GridCell{ CoordinateOf(grid->slots[slot].key), grid->slots[slot].value };
+			}
+			Iterator& operator++()
+			{
+				slot++;
+				SkipEmptySlots();
+				return *this;
+			}
+
+			friend bool operator==(Iterator const& itr1, Iterator const& itr2)
+			{
+				return (itr1.grid == itr2.grid) && (itr1.slot == itr2.slot);
+			}
+			friend bool operator!=(Iterator const& itr1, Iterator const& itr2) { return !(itr1 == itr2); }
+		};
+		Iterator begin() { return Iterator{ *this, 0 }; }
+		Iterator end() { return Iterator{ *this, slots.size() }; }
+	};
+
+	// Whether a grid is better held densely (as a Grid, say) than sparsely as a SparseGrid<T>,
+	// given how much memory the dense grid would take and how many cells are expected to be
+	// in use. Dense storage is quicker to work with, so it's preferred unless it would take
+	// up more than a few times as much memory as sparse storage would.
+	template <typename T>
+	bool DenseStorageIsWorthwhile(std::size_t denseBytes, std::size_t cellsInUse)
+	{
+		constexpr std::size_t denseMemoryAllowance{ 4 };
+		return denseBytes <= (denseMemoryAllowance * cellsInUse * SparseGrid<T>::bytesPerStoredCell);
+	}
+
+	// Stencils over grids of bytes which come up often enough to be worth hand vectorising.
+	// These work through 32 cells at a time with AVX2 (16 with SSE2) where the compiler has
+	// been told it can use them, as the Release builds are, and fall back to plain loops
+	// otherwise.
+	// Set each cell of sums to the total of the neighbours of that cell in source.
+	void NeighbourSums(
+		PaddedGrid<std::uint8_t> const& source,
+		PaddedGrid<std::uint8_t>& sums,
+		Neighbourhood neighbourhood,
+		unsigned int rowBands = 1);
+
+	// Set each cell of minima to 1 if that cell of source is strictly lower than every one of
+	// its neighbours, or 0 otherwise.
+	void StrictLocalMinima(
+		PaddedGrid<std::uint8_t> const& source,
+		PaddedGrid<std::uint8_t>& minima,
+		Neighbourhood neighbourhood,
+		unsigned int rowBands = 1);
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "puzzle_input.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Map the whole file read-only. An empty file can't be mapped, but is still a perfectly
+// good (if unhelpful) input, so it counts as open with empty contents. A file whose size
+// can't be found counts as not opened at all.
+PuzzleInput::MappedFile::MappedFile(std::filesystem::path pathToFile) : path{ std::move(pathToFile) }
+{
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) { return; }
+
+	// If we can't even tell how big the file is, it can't be read either.
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return;
+	}
+	if (fileSize.QuadPart > 0)
+	{
+		HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle != nullptr)
+		{
+			mappedData = static_cast<char const*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mappingHandle);
+		}
+		isOpen = (mappedData != nullptr);
+		mappedSize = isOpen ? static_cast<std::size_t>(fileSize.QuadPart) : 0;
+	}
+	else
+	{
+		isOpen = true;
+	}
+	CloseHandle(fileHandle);
+#else
+	int fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) { return; }
+
+	struct stat fileStats{};
+	if (fstat(fileDescriptor, &fileStats) != 0)
+	{
+		close(fileDescriptor);
+		return;
+	}
+	if (fileStats.st_size > 0)
+	{
+		void* mapping = mmap(nullptr, fileStats.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (mapping != MAP_FAILED)
+		{
+			// Solvers almost always read their input from front to back.
+			madvise(mapping, fileStats.st_size, MADV_SEQUENTIAL);
+			mappedData = static_cast<char const*>(mapping);
+			mappedSize = static_cast<std::size_t>(fileStats.st_size);
+			isOpen = true;
+		}
+	}
+	else
+	{
+		isOpen = true;
+	}
+	close(fileDescriptor);
+#endif
+}
+
+PuzzleInput::MappedFile::~MappedFile()
+{
+	Unmap();
+}
+
+PuzzleInput::MappedFile::MappedFile(MappedFile&& otherFile) noexcept :
+	path{ std::move(otherFile.path) },
+	mappedData{ std::exchange(otherFile.mappedData, nullptr) },
+	mappedSize{ std::exchange(otherFile.mappedSize, 0) },
+	isOpen{ std::exchange(otherFile.isOpen, false) }
+{
+}
+
+PuzzleInput::MappedFile& PuzzleInput::MappedFile::operator=(MappedFile&& otherFile) noexcept
+{
+	if (this != &otherFile)
+	{
+		Unmap();
+		path = std::move(otherFile.path);
+		mappedData = std::exchange(otherFile.mappedData, nullptr);
+		mappedSize = std::exchange(otherFile.mappedSize, 0);
+		isOpen = std::exchange(otherFile.isOpen, false);
+	}
+	return *this;
+}
+
+void PuzzleInput::MappedFile::Unmap()
+{
+	if (mappedData != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(mappedData);
+#else
+		munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+		mappedData = nullptr;
+		mappedSize = 0;
+	}
+}
+
+void PuzzleInput::MappedFile::Prefault() const
+{
+	// The byte read from each page is never looked at, it's just volatile so that the reads
+	// can't be optimised away.
+	constexpr std::size_t pageSize = 4096;
+	[[maybe_unused]] volatile char touchedByte{ 0 };
+	for (std::size_t offset = 0; offset < mappedSize; offset += pageSize)
+	{
+		touchedByte = mappedData[offset];
+	}
+}
+
+// Take everything up to the next newline as the current line, dropping any carriage
+// return from a Windows line ending, and move past the newline ready for the next one.
+void PuzzleInput::LineIterator::FindNextLine()
+{
+	atEnd = remainingText.empty();
+	if (atEnd) { return; }
+
+	std::size_t newlinePosition = remainingText.find('\n');
+	if (newlinePosition == std::string_view::npos)
+	{
+		currentLine = remainingText;
+		remainingText.remove_prefix(remainingText.size());
+	}
+	else
+	{
+		currentLine = remainingText.substr(0, newlinePosition);
+		remainingText.remove_prefix(newlinePosition + 1);
+	}
+
+	if (!currentLine.empty() && (currentLine.back() == '\r'))
+	{
+		currentLine.remove_suffix(1);
+	}
+}
+
+// Skip any delimiters, then take everything up to the next delimiter as the current token.
+void PuzzleInput::TokenIterator::FindNextToken()
+{
+	std::size_t tokenStart = remainingText.find_first_not_of(delimiters);
+	atEnd = (tokenStart == std::string_view::npos);
+	if (atEnd)
+	{
+		remainingText.remove_prefix(remainingText.size());
+		return;
+	}
+
+	remainingText.remove_prefix(tokenStart);
+	std::size_t tokenLength = remainingText.find_first_of(delimiters);
+	if (tokenLength == std::string_view::npos) { tokenLength = remainingText.size(); }
+	currentToken = remainingText.substr(0, tokenLength);
+	remainingText.remove_prefix(tokenLength);
+}
+
+PuzzleInput::Range<PuzzleInput::LineIterator> PuzzleInput::Lines(std::string_view text)
+{
+	return Range<LineIterator>{ LineIterator{ text }, LineIterator{} };
+}
+
+PuzzleInput::Range<PuzzleInput::TokenIterator> PuzzleInput::Tokens(std::string_view text, std::string_view delimiters)
+{
+	return Range<TokenIterator>{ TokenIterator{ text, delimiters }, TokenIterator{} };
+}
+
+std::string_view PuzzleInput::RemainingText(std::istream& input, std::string& storage)
+{
+	if (ViewStreamBuffer* viewBuffer = dynamic_cast<ViewStreamBuffer*>(input.rdbuf()))
+	{
+		return viewBuffer->TakeRemainingText();
+	}
+
+	storage.clear();
+	std::size_t bytesRead{ 0 };
+	while (input)
+	{
+		storage.resize(bytesRead + streamChunkSize);
+		input.read(storage.data() + bytesRead, streamChunkSize);
+		bytesRead += static_cast<std::size_t>(input.gcount());
+	}
+	storage.resize(bytesRead);
+	return storage;
+}
+
+// Aim for equal sized chunks, but carry each chunk on to the end of whatever record it
+// would otherwise have finished part way through. A chunk can be swallowed entirely by a
+// long record in the chunk before, in which case there are just fewer chunks.
+std::vector<std::string_view> PuzzleInput::SplitIntoChunks(std::string_view text, std::size_t numberOfChunks, std::string_view delimiters)
+{
+	std::vector<std::string_view> chunks{};
+	std::size_t targetChunkSize = (numberOfChunks > 0) ? ((text.size() / numberOfChunks) + 1) : text.size();
+	std::size_t chunkStart{ 0 };
+	do
+	{
+		std::size_t chunkEnd = text.size();
+		if ((text.size() - chunkStart) > targetChunkSize)
+		{
+			std::size_t delimiterPosition = text.find_first_of(delimiters, chunkStart + targetChunkSize);
+			if (delimiterPosition != std::string_view::npos) { chunkEnd = delimiterPosition + 1; }
+		}
+		chunks.push_back(text.substr(chunkStart, chunkEnd - chunkStart));
+		chunkStart = chunkEnd;
+	} while (chunkStart < text.size());
+	return chunks;
+}
+
+std::size_t PuzzleInput::NumberOfParallelChunks(std::size_t textSize)
+{
+	std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	return std::clamp<std::size_t>(textSize / minimumParallelChunkSize, 1, hardwareThreads);
+}
@@ -0,0 +1,292 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// A puzzle input file mapped straight into memory, so that solvers can parse it in place
+// through a std::string_view rather than copying every line out of an iostream into a
+// fresh std::string. Lines and tokens are handed out as views into the mapping, so they
+// are only valid for as long as the MappedFile they came from.
+namespace PuzzleInput
+{
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(std::filesystem::path pathToFile);
+		~MappedFile();
+
+		// The mapping is owned by exactly one MappedFile, so can be moved but not copied.
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+		MappedFile(MappedFile&& otherFile) noexcept;
+		MappedFile& operator=(MappedFile&& otherFile) noexcept;
+
+		bool IsOpen() const { return isOpen; }
+		std::string_view Contents() const { return std::string_view{ mappedData, mappedSize }; }
+		std::filesystem::path const& Path() const { return path; }
+
+		// Touch every page of the mapping, so that the file has actually been read into
+		// memory before any solver gets to it rather than being faulted in as it's parsed.
+		void Prefault() const;
+
+	private:
+		void Unmap();
+
+		std::filesystem::path path{};
+		char const* mappedData{ nullptr };
+		std::size_t mappedSize{ 0 };
+		bool isOpen{ false };
+	};
+
+	// Lets a block of text be read through a std::istream without copying it, for the
+	// solvers which still parse their input with stream extraction and std::getline.
+	// The text is only ever read from, despite std::streambuf wanting non-const pointers.
+	// Reading a file in text mode turns Windows line endings into plain newlines, so the
+	// same is done here: the stream is handed the text in pieces that stop short of the
+	// carriage return of each "\r\n", and the next piece picks up from the newline.
+	class ViewStreamBuffer : public std::streambuf
+	{
+	public:
+		explicit ViewStreamBuffer(std::string_view textIn) : text{ textIn }
+		{
+			ReadPieceFrom(0);
+		}
+
+		// Hand back whatever of the text hasn't been read yet, and mark it all as read.
+		// This is the text as it is, Windows line endings and all.
+		std::string_view TakeRemainingText()
+		{
+			std::size_t position = static_cast<std::size_t>(gptr() - text.data());
+			ReadPieceFrom(text.size());
+			return text.substr(position);
+		}
+
+	protected:
+		// The current piece has run out, which is either the end of the text or the carriage
+		// return of a Windows line ending, which is skipped.
+		int_type underflow() override
+		{
+			std::size_t position = static_cast<std::size_t>(egptr() - text.data());
+			if (position >= text.size()) { return traits_type::eof(); }
+			ReadPieceFrom(position + 1);
+			return traits_type::to_int_type(*gptr());
+		}
+
+	private:
+		std::string_view text;
+
+		void ReadPieceFrom(std::size_t pieceStart)
+		{
+			std::size_t pieceEnd = text.find("\r\n", pieceStart);
+			if (pieceEnd == std::string_view::npos) { pieceEnd = text.size(); }
+			char* textStart = const_cast<char*>(text.data());
+			setg(textStart + pieceStart, textStart + pieceStart, textStart + pieceEnd);
+		}
+	};
+
+	// Everything left to read from a stream as a single block of text. If the stream is
+	// reading from a ViewStreamBuffer, this is just a view of the rest of that text, and
+	// nothing is copied. Otherwise the rest of the stream is read into storage, which must
+	// outlive the returned view.
+	std::string_view RemainingText(std::istream& input, std::string& storage);
+
+	// Walks through a block of text a line at a time, without the line endings (either
+	// "\n" or "\r\n"). A final line without a trailing newline is still visited, but
+	// a trailing newline at the very end of the text doesn't produce an empty last line.
+	class LineIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::string_view const*;
+		using reference = std::string_view const&;
+
+		LineIterator() = default;
+		explicit LineIterator(std::string_view text) : remainingText{ text } { FindNextLine(); }
+
+		reference operator*() const { return currentLine; }
+		pointer operator->() const { return &currentLine; }
+		LineIterator& operator++() { FindNextLine(); return *this; }
+		LineIterator operator++(int) { LineIterator previous{ *this }; FindNextLine(); return previous; }
+		bool operator==(LineIterator const& other) const
+		{
+			return (atEnd == other.atEnd) && (atEnd || (remainingText.data() == other.remainingText.data()));
+		}
+		bool operator!=(LineIterator const& other) const { return !(*this == other); }
+
+	private:
+		void FindNextLine();
+
+		std::string_view remainingText{};
+		std::string_view currentLine{};
+		bool atEnd{ true };
+	};
+
+	// Walks through a block of text a token at a time, where tokens are separated by
+	// one or more of a set of delimiter characters (by default, any whitespace). Empty
+	// tokens are skipped over, so "1,,2" with a comma delimiter gives "1" then "2".
+	class TokenIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::string_view const*;
+		using reference = std::string_view const&;
+
+		TokenIterator() = default;
+		TokenIterator(std::string_view text, std::string_view delimiters) :
+			remainingText{ text }, delimiters{ delimiters } { FindNextToken(); }
+
+		reference operator*() const { return currentToken; }
+		pointer operator->() const { return &currentToken; }
+		TokenIterator& operator++() { FindNextToken(); return *this; }
+		TokenIterator operator++(int) { TokenIterator previous{ *this }; FindNextToken(); return previous; }
+		bool operator==(TokenIterator const& other) const
+		{
+			return (atEnd == other.atEnd) && (atEnd || (remainingText.data() == other.remainingText.data()));
+		}
+		bool operator!=(TokenIterator const& other) const { return !(*this == other); }
+
+	private:
+		void FindNextToken();
+
+		std::string_view remainingText{};
+		std::string_view delimiters{};
+		std::string_view currentToken{};
+		bool atEnd{ true };
+	};
+
+	// Simple ranges so the iterators can be used in range-based for loops, e.g.
+	//     for (std::string_view line : PuzzleInput::Lines(puzzleInput.Contents()))
+	template <typename Iterator>
+	struct Range
+	{
+		Iterator first;
+		Iterator last;
+		Iterator begin() const { return first; }
+		Iterator end() const { return last; }
+	};
+
+	constexpr std::string_view whitespace{ " \t\r\n" };
+	constexpr std::string_view lineEndings{ "\r\n" };
+
+	Range<LineIterator> Lines(std::string_view text);
+	Range<TokenIterator> Tokens(std::string_view text, std::string_view delimiters = whitespace);
+
+	// Inputs are only split between threads into chunks of at least this size, below which
+	// starting the threads would take longer than the parsing itself. Real puzzle inputs
+	// are all smaller than this, so only generated inputs are ever parsed in parallel.
+	constexpr std::size_t minimumParallelChunkSize = 256 * 1024;
+
+	// Split a block of text into up to numberOfChunks chunks of roughly equal size. Each
+	// chunk boundary is moved on to just after the next delimiter, so that no record is
+	// split between two chunks. There's always at least one chunk, even for empty text.
+	std::vector<std::string_view> SplitIntoChunks(std::string_view text, std::size_t numberOfChunks, std::string_view delimiters);
+
+	// One chunk per hardware thread, unless that would make the chunks smaller than
+	// minimumParallelChunkSize.
+	std::size_t NumberOfParallelChunks(std::size_t textSize);
+
+	// Split the text into chunks as above and run chunkWork on each one, the first on the
+	// calling thread and the rest on threads of their own. The results are returned in the
+	// same order as the chunks appear in the text, so can be concatenated or merged in
+	// order. chunkWork must be safe to call from several threads at once.
+	template <typename ChunkWork>
+	auto ForEachChunkInParallel(std::string_view text, std::string_view delimiters, ChunkWork chunkWork)
+	{
+		using ChunkResult = std::invoke_result_t<ChunkWork&, std::string_view>;
+		std::vector<std::string_view> chunks = SplitIntoChunks(text, NumberOfParallelChunks(text.size()), delimiters);
+
+		std::vector<std::future<ChunkResult>> laterChunkResults{};
+		for (std::size_t ii = 1; ii < chunks.size(); ii++)
+		{
+			laterChunkResults.push_back(std::async(std::launch::async, chunkWork, chunks[ii]));
+		}
+
+		std::vector<ChunkResult> chunkResults{};
+		chunkResults.reserve(chunks.size());
+		chunkResults.push_back(chunkWork(chunks[0]));
+		for (std::future<ChunkResult>& chunkResult : laterChunkResults)
+		{
+			chunkResults.push_back(chunkResult.get());
+		}
+		return chunkResults;
+	}
+
+	// Parse every non-empty line of the text into a record, e.g.
+	//     PuzzleInput::ParseLinesInParallel<Path>(text, [](std::string_view line) { return ParsePath(line); });
+	// splitting the text between threads if it's big enough to be worth it. The records
+	// come back in the same order as the lines they were parsed from.
+	template <typename Record, typename LineParser>
+	std::vector<Record> ParseLinesInParallel(std::string_view text, LineParser parseLine)
+	{
+		std::vector<std::vector<Record>> chunkRecords = ForEachChunkInParallel(text, lineEndings,
+			[&parseLine](std::string_view chunk)
+			{
+				std::vector<Record> records{};
+				for (std::string_view line : Tokens(chunk, lineEndings))
+				{
+					records.push_back(parseLine(line));
+				}
+				return records;
+			});
+		if (chunkRecords.size() == 1) { return std::move(chunkRecords[0]); }
+
+		std::size_t totalRecords{ 0 };
+		for (std::vector<Record> const& records : chunkRecords) { totalRecords += records.size(); }
+		std::vector<Record> allRecords{};
+		allRecords.reserve(totalRecords);
+		for (std::vector<Record>& records : chunkRecords)
+		{
+			std::move(records.begin(), records.end(), std::back_inserter(allRecords));
+		}
+		return allRecords;
+	}
+
+	// How much of a stream is read in at a time by ForEachToken.
+	constexpr std::size_t streamChunkSize = 64 * 1024;
+
+	// The push-style equivalent of Tokens, for input which can't be mapped (e.g. a pipe).
+	// The stream is read a chunk at a time, and each token is handed to the consumer as soon
+	// as the chunk it ends in has been read, as a view which is only valid during the call.
+	// Only the chunk and any partial token at the end of it are held at once, so the stream
+	// can be far larger than memory. The buffer only grows if a single token won't fit in it.
+	template <typename TokenConsumer>
+	void ForEachToken(std::istream& input, std::string_view delimiters, TokenConsumer&& consumeToken)
+	{
+		std::string buffer(streamChunkSize, '\0');
+		std::size_t carriedOver{ 0 };
+		while (input)
+		{
+			if (carriedOver == buffer.size()) { buffer.resize(buffer.size() * 2); }
+			input.read(buffer.data() + carriedOver, buffer.size() - carriedOver);
+			std::size_t bytesInBuffer = carriedOver + static_cast<std::size_t>(input.gcount());
+
+			// Everything up to the last delimiter in the buffer is made up of complete tokens,
+			// while anything after it might carry on into the next chunk.
+			std::string_view bufferedText{ buffer.data(), bytesInBuffer };
+			std::size_t lastDelimiter = bufferedText.find_last_of(delimiters);
+			std::size_t completeLength = (lastDelimiter == std::string_view::npos) ? 0 : (lastDelimiter + 1);
+			for (std::string_view token : Tokens(bufferedText.substr(0, completeLength), delimiters))
+			{
+				consumeToken(token);
+			}
+			carriedOver = bytesInBuffer - completeLength;
+			std::memmove(buffer.data(), buffer.data() + completeLength, carriedOver);
+		}
+		if (carriedOver > 0)
+		{
+			consumeToken(std::string_view{ buffer.data(), carriedOver });
+		}
+	}
+}
@@ -0,0 +1,148 @@
+#include "timing.h"
+#include <iomanip>
+
+namespace
+{
+	// Each thread keeps its own list of phases, so that solvers running in parallel
+	// never need to synchronise with each other just to record a timing.
+	thread_local bool recordingPhases{ false };
+	thread_local std::vector<Timing::PhaseTiming> recordedPhases{};
+
+	// Phase names are chosen by the solvers, so make sure any quotes or backslashes
+	// in them can't break the JSON report.
+	std::string EscapeForJson(std::string const& rawString)
+	{
+		std::string escapedString{};
+		for (char character : rawString)
+		{
+			if ((character == '"') || (character == '\\')) { escapedString += '\\'; }
+			escapedString += character;
+		}
+		return escapedString;
+	}
+
+	// Likewise, quotes within a quoted CSV field need doubling up.
+	std::string EscapeForCsv(std::string const& rawString)
+	{
+		std::string escapedString{};
+		for (char character : rawString)
+		{
+			if (character == '"') { escapedString += '"'; }
+			escapedString += character;
+		}
+		return escapedString;
+	}
+}
+
+double Timing::MillisecondsSince(Clock::time_point startTime)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+}
+
+// Start recording phases for this thread, throwing away anything left over from
+// a previous recording.
+void Timing::BeginPhaseRecording()
+{
+	recordedPhases.clear();
+	recordingPhases = true;
+}
+
+// Stop recording phases for this thread, and hand back everything that was recorded,
+// in the order that the phases finished.
+std::vector<Timing::PhaseTiming> Timing::EndPhaseRecording()
+{
+	recordingPhases = false;
+	std::vector<PhaseTiming> phases{};
+	phases.swap(recordedPhases);
+	return phases;
+}
+
+void Timing::RecordPhase(std::string phaseName, double milliseconds)
+{
+	if (recordingPhases)
+	{
+		recordedPhases.push_back(PhaseTiming{ phaseName, milliseconds });
+	}
+}
+
+Timing::ScopedTimer::~ScopedTimer()
+{
+	RecordPhase(phaseName, MillisecondsSince(startTime));
+}
+
+// Print a human-readable table with a row per day, showing the time taken to open the
+// input and to solve the puzzle, followed by whatever phases that day's solver reported.
+void Timing::PrintBreakdownTable(std::ostream& outputStream, std::vector<DayTimings> const& allTimings)
+{
+	double totalInputMilliseconds{ 0 };
+	double totalSolveMilliseconds{ 0 };
+
+	outputStream << " Day | Input (ms) | Solve (ms) | Phases (ms)\n";
+	outputStream << "-----+------------+------------+------------\n";
+	outputStream << std::fixed << std::setprecision(3);
+	for (DayTimings const& dayTimings : allTimings)
+	{
+		outputStream << std::setw(4) << dayTimings.day << " | " <<
+			std::setw(10) << dayTimings.inputOpenMilliseconds << " | " <<
+			std::setw(10) << dayTimings.solveMilliseconds << " | ";
+		for (unsigned int ii = 0; ii < dayTimings.phases.size(); ii++)
+		{
+			if (ii > 0) { outputStream << ", "; }
+			outputStream << dayTimings.phases[ii].name << " " << dayTimings.phases[ii].milliseconds;
+		}
+		outputStream << "\n";
+
+		totalInputMilliseconds += dayTimings.inputOpenMilliseconds;
+		totalSolveMilliseconds += dayTimings.solveMilliseconds;
+	}
+	outputStream << "-----+------------+------------+------------\n";
+	outputStream << " All | " << std::setw(10) << totalInputMilliseconds << " | " <<
+		std::setw(10) << totalSolveMilliseconds << " |" << std::endl;
+	outputStream << std::defaultfloat;
+}
+
+// Write out the timings as a JSON object of the form:
+// {"days":[{"day":1,"input_open_ms":0.1,"solve_ms":2.3,"phases":[{"name":"parse","ms":1.2}]}]}
+void Timing::WriteJsonReport(std::ostream& outputStream, std::vector<DayTimings> const& allTimings)
+{
+	outputStream << std::fixed << std::setprecision(6);
+	outputStream << "{\"days\":[";
+	for (unsigned int dayIndex = 0; dayIndex < allTimings.size(); dayIndex++)
+	{
+		DayTimings const& dayTimings = allTimings[dayIndex];
+		if (dayIndex > 0) { outputStream << ","; }
+		outputStream << "\n  {\"day\":" << dayTimings.day <<
+			",\"input_open_ms\":" << dayTimings.inputOpenMilliseconds <<
+			",\"solve_ms\":" << dayTimings.solveMilliseconds <<
+			",\"phases\":[";
+		for (unsigned int ii = 0; ii < dayTimings.phases.size(); ii++)
+		{
+			if (ii > 0) { outputStream << ","; }
+			outputStream << "{\"name\":\"" << EscapeForJson(dayTimings.phases[ii].name) <<
+				"\",\"ms\":" << dayTimings.phases[ii].milliseconds << "}";
+		}
+		outputStream << "]}";
+	}
+	outputStream << "\n]}" << std::endl;
+	outputStream << std::defaultfloat;
+}
+
+// Write out the timings as CSV, with one row per measurement. The input open and
+// overall solve times are reported as the "input" and "solve" phases of each day,
+// alongside any phases reported by the solver itself.
+void Timing::WriteCsvReport(std::ostream& outputStream, std::vector<DayTimings> const& allTimings)
+{
+	outputStream << std::fixed << std::setprecision(6);
+	outputStream << "day,phase,ms\n";
+	for (DayTimings const& dayTimings : allTimings)
+	{
+		outputStream << dayTimings.day << ",input," << dayTimings.inputOpenMilliseconds << "\n";
+		outputStream << dayTimings.day << ",solve," << dayTimings.solveMilliseconds << "\n";
+		for (PhaseTiming const& phase : dayTimings.phases)
+		{
+			outputStream << dayTimings.day << ",\"" << EscapeForCsv(phase.name) << "\"," << phase.milliseconds << "\n";
+		}
+	}
+	outputStream << std::defaultfloat;
+	outputStream.flush();
+}
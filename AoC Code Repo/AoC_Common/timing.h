@@ -0,0 +1,66 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Utilities for measuring where the time goes when solving a puzzle. The solver driver
+// times each day as a whole, while individual solvers can break that time down further
+// by dropping a ScopedTimer into each interesting phase of their work (e.g. parsing
+// the input, or solving part 1). Recorded timings can then be reported as a readable
+// table, or as JSON/CSV for comparing between builds.
+namespace Timing
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Number of milliseconds elapsed since a given point in time.
+	double MillisecondsSince(Clock::time_point startTime);
+
+	// A named portion of a solver's work, and how long it took.
+	struct PhaseTiming
+	{
+		std::string name;
+		double milliseconds;
+	};
+
+	// Phases are recorded against whichever thread they ran on, so that days being
+	// solved in parallel don't get their phases mixed up. The driver begins recording
+	// before calling a solver, and collects the phases recorded once it returns. Any
+	// ScopedTimers that finish while a thread isn't recording are simply discarded.
+	void BeginPhaseRecording();
+	std::vector<PhaseTiming> EndPhaseRecording();
+	void RecordPhase(std::string phaseName, double milliseconds);
+
+	// Times the scope it lives in, recording the result as a named phase when it is
+	// destroyed. Intended to be used like:
+	//     {
+	//         Timing::ScopedTimer timer{ "parse" };
+	//         ...
+	//     }
+	class ScopedTimer
+	{
+	private:
+		std::string phaseName;
+		Clock::time_point startTime;
+	public:
+		ScopedTimer(std::string phaseName) : phaseName{ phaseName }, startTime{ Clock::now() } {};
+		~ScopedTimer();
+
+		ScopedTimer(ScopedTimer const&) = delete;
+		ScopedTimer& operator=(ScopedTimer const&) = delete;
+	};
+
+	// Everything we timed about a single day: opening its input, running its solver
+	// (which includes any time spent in the phases), and the phases the solver reported.
+	struct DayTimings
+	{
+		unsigned int day{ 0 };
+		double inputOpenMilliseconds{ 0 };
+		double solveMilliseconds{ 0 };
+		std::vector<PhaseTiming> phases{};
+	};
+
+	void PrintBreakdownTable(std::ostream& outputStream, std::vector<DayTimings> const& allTimings);
+	void WriteJsonReport(std::ostream& outputStream, std::vector<DayTimings> const& allTimings);
+	void WriteCsvReport(std::ostream& outputStream, std::vector<DayTimings> const& allTimings);
+}
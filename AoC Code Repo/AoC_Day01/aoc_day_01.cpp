@@ -1,45 +1,58 @@
-#include <iostream>
+#include <array>
 #include <cassert>
 #include "Parsing.h"
+#include "puzzle_input.h"
 #include "puzzle_solvers.h"
 
-// Day 1 was a simple case of comparing the relative size of subsequent elements in a list
-// of ints, with part 2 instead comparing the relative size of subsequent groups of ints.
-PuzzleAnswerPair PuzzleSolvers::AocDayOneSolver(std::ifstream &puzzleInputFile)
+namespace
 {
-	PuzzleAnswerPair puzzleAnswerPair{};
-	int totalGreaterThans{ 0 };
-
-	// Puzzle input for today is a whole load of ints, each on its own line, so
-	// let's turn that into a vector.
-	std::vector<int> parsedValues = Parsing::SeparateOnWhitespace<int>(puzzleInputFile);
-	assert(parsedValues.size() > 1);
-
-	// Part 1, how many times is an element larger than the previous element.
-	for (unsigned int ii = 1; ii < parsedValues.size(); ii++)
+	// Puzzle input for today is a whole load of ints, each on its own line. Each depth only
+	// ever needs comparing with those up to 3 before it, so rather than keeping the whole
+	// list we just keep a window of the last 3 depths seen.
+	class DepthSweepSolver
 	{
-		if (parsedValues[ii] > parsedValues[ii - 1])
+	public:
+		static constexpr std::string_view recordDelimiters{ PuzzleInput::whitespace };
+
+		void ConsumeRecord(std::string_view record)
 		{
-			totalGreaterThans++;
+			int depth = Parsing::ConvertValidNumber<int>(record);
+
+			// Part 1, how many times is an element larger than the previous element.
+			// Although what we're really comparing in part 2 is the relative sizes of groups of
+			// 3 elements, there are two elements of overlap between each group of 3, so we can
+			// simplify the problem a little by just calculating how many times an element is
+			// greater than that 3 spaces before it.
+			if ((depthsSeen >= 1) && (depth > previousDepths[(depthsSeen - 1) % windowSize])) { singleIncreases++; }
+			if ((depthsSeen >= 3) && (depth > previousDepths[(depthsSeen - 3) % windowSize])) { windowIncreases++; }
+
+			previousDepths[depthsSeen % windowSize] = depth;
+			depthsSeen++;
 		}
-	}
-	puzzleAnswerPair.first = std::to_string(totalGreaterThans);
-
-	// Although what we're really comparing in part 2 is the relative sizes of groups of
-	// 3 elements, there are two elements of overlap between each group of 3, so we can
-	// simplify the problem a little by just calculating how many times an element is
-	// greater than that 3 spaces before it.
-	totalGreaterThans = 0;
-	for (unsigned int ii = 3; ii < parsedValues.size(); ii++)
-	{
-		if (parsedValues[ii] > parsedValues[ii - 3])
+
+		PuzzleAnswerPair Answers() const
 		{
-			totalGreaterThans++;
+			assert(depthsSeen > 1);
+			return PuzzleAnswerPair{ std::to_string(singleIncreases), std::to_string(windowIncreases) };
 		}
-	}
-	puzzleAnswerPair.second = std::to_string(totalGreaterThans);
 
-	puzzleInputFile.close();
+	private:
+		static constexpr unsigned int windowSize = 3;
+		std::array<int, windowSize> previousDepths{};
+		ULLINT depthsSeen{ 0 };
+		ULLINT singleIncreases{ 0 };
+		ULLINT windowIncreases{ 0 };
+	};
+}
 
-	return puzzleAnswerPair;
-}
\ No newline at end of file
+// Day 1 was a simple case of comparing the relative size of subsequent elements in a list
+// of ints, with part 2 instead comparing the relative size of subsequent groups of ints.
+PuzzleAnswerPair PuzzleSolvers::AocDayOneSolver(PuzzleInput::MappedFile const& puzzleInput)
+{
+	return SolveMappedInput<DepthSweepSolver>(puzzleInput);
+}
+
+PuzzleAnswerPair PuzzleSolvers::AocDayOneStreamingSolver(std::istream& puzzleInputStream)
+{
+	return SolveInputStream<DepthSweepSolver>(puzzleInputStream);
+}
@@ -4,7 +4,7 @@
 
 // Convert a direction from string format (case-sensitive) into the equivalent
 // Direction enum for easier use elsewhere in this namespace.
-Navigation::Direction Navigation::GetDirectionFromString(std::string directionString)
+Navigation::Direction Navigation::GetDirectionFromString(std::string_view directionString)
 {
 	Direction directionToReturn;
 
@@ -63,12 +63,12 @@ void Navigation::Position::ApplyMovementWithAim(MovementCommand movement)
 	}
 }
 
-int Navigation::Position::GetProductOfPositions() const
+LLINT Navigation::Position::GetProductOfPositions() const
 {
 	return horizontalPosition * verticalPosition;
 }
 
-int Navigation::Position::GetProductOfPositionsInvertingDepth() const
+LLINT Navigation::Position::GetProductOfPositionsInvertingDepth() const
 {
 	return horizontalPosition * depth();
 }
@@ -1,10 +1,11 @@
 #pragma once
-#include <string>
+#include <string_view>
+#include "aoc_common_types.h"
 
 namespace Navigation {
 
 	enum Direction { Up, Down, Forwards };
-	Direction GetDirectionFromString(std::string directionString);
+	Direction GetDirectionFromString(std::string_view directionString);
 
 	// A command to move something according today's puzzle input scheme takes a direction and a magnitude.
 	struct MovementCommand {
@@ -21,17 +22,18 @@ namespace Navigation {
 	// to translate the position.
 	// Can return the product of the two position components, either as a direct multiplication,
 	// or by inverting the vertical position to account for a submarine position where negative
-	// vertical position indicates positive depth.
+	// vertical position indicates positive depth. Positions are kept as 64 bit integers, as
+	// the part 2 depth grows with the square of the number of commands on large inputs.
 	class Position {
 	private:
-		int horizontalPosition{ 0 };
-		int verticalPosition{ 0 };
-		int aim{ 0 };
-		int depth() const { return verticalPosition * -1; }
+		LLINT horizontalPosition{ 0 };
+		LLINT verticalPosition{ 0 };
+		LLINT aim{ 0 };
+		LLINT depth() const { return verticalPosition * -1; }
 	public:
 		void ApplyMovement(MovementCommand movement);
 		void ApplyMovementWithAim(MovementCommand movement);
-		int GetProductOfPositions() const;
-		int GetProductOfPositionsInvertingDepth() const;
+		LLINT GetProductOfPositions() const;
+		LLINT GetProductOfPositionsInvertingDepth() const;
 	};
 }
\ No newline at end of file
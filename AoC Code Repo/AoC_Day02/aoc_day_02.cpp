@@ -1,35 +1,55 @@
 #include "Navigation.h"
-#include "Parsing.h"
-#include <iostream>
 #include <string>
+#include "Parsing.h"
 #include "puzzle_solvers.h"
 
-// Day 2 tracks the position of a submarine as a series of movement commands are applied to
-// it.
-// The simple submarine of part 1 applies movement commands in one way, while the part 2
-// submarine adopts a more complex approach involving 'aim'.
-PuzzleAnswerPair PuzzleSolvers::AocDayTwoSolver(std::ifstream &puzzleInputFile)
+namespace
 {
-	Navigation::Position simpleSubmarinePosition;
-	Navigation::Position moreComplexSubmarinePosition;
+	// Each command only moves the submarines on from where they are now, so commands can be
+	// applied as they're read without ever keeping the list of them.
+	class SubmarineCourseSolver
+	{
+	public:
+		static constexpr std::string_view recordDelimiters{ PuzzleInput::lineEndings };
+		using CommandRecord = Parsing::Record<Parsing::Word, Parsing::Sep<' '>, Parsing::Int>;
 
-	std::vector<std::string> commandList = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
+		// Parse each command into the constituent direction and magnitude components
+		// (e.g. "forward 5"), using these to create a MovementCommand we can apply to each
+		// of our submarines.
+		void ConsumeRecord(std::string_view record)
+		{
+			std::string_view direction{};
+			int magnitude{ 0 };
+			CommandRecord::ParseValid(record, direction, magnitude);
+			Navigation::MovementCommand command{ Navigation::GetDirectionFromString(direction), magnitude };
 
-	// For each command in the list, parse it into the constituent direction and magnitude
-	// components, using these to create a MovementCommand we can apply to each of our submarines.
-	for (std::string singleDirection : commandList)
-	{
-		std::string directionStr{};
-		int magnitude{};
+			simpleSubmarinePosition.ApplyMovement(command);
+			moreComplexSubmarinePosition.ApplyMovementWithAim(command);
+		}
 
-		Parsing::ParseStringIntoElements(singleDirection, std::regex{ "([a-z]+) ([0-9]+)" }, directionStr, magnitude);
-		Navigation::MovementCommand command { Navigation::GetDirectionFromString(directionStr), magnitude };
+		PuzzleAnswerPair Answers() const
+		{
+			return PuzzleAnswerPair{
+				std::to_string(simpleSubmarinePosition.GetProductOfPositionsInvertingDepth()) ,
+				std::to_string(moreComplexSubmarinePosition.GetProductOfPositionsInvertingDepth()) };
+		}
 
-		simpleSubmarinePosition.ApplyMovement(command);
-		moreComplexSubmarinePosition.ApplyMovementWithAim(command);
-	}
+	private:
+		Navigation::Position simpleSubmarinePosition;
+		Navigation::Position moreComplexSubmarinePosition;
+	};
+}
 
-	return PuzzleAnswerPair{
-		std::to_string(simpleSubmarinePosition.GetProductOfPositionsInvertingDepth()) ,
-		std::to_string(moreComplexSubmarinePosition.GetProductOfPositionsInvertingDepth()) };
-}
\ No newline at end of file
+// Day 2 tracks the position of a submarine as a series of movement commands are applied to
+// it.
+// The simple submarine of part 1 applies movement commands in one way, while the part 2
+// submarine adopts a more complex approach involving 'aim'.
+PuzzleAnswerPair PuzzleSolvers::AocDayTwoSolver(PuzzleInput::MappedFile const& puzzleInput)
+{
+	return SolveMappedInput<SubmarineCourseSolver>(puzzleInput);
+}
+
+PuzzleAnswerPair PuzzleSolvers::AocDayTwoStreamingSolver(std::istream& puzzleInputStream)
+{
+	return SolveInputStream<SubmarineCourseSolver>(puzzleInputStream);
+}
@@ -1,175 +1,162 @@
 #include "Binary.h"
-#include <math.h>
 #include <cassert>
 
-// To perform a bitwise-AND with an unsigned int, we need to access the decimal
-// value inside a BinaryNumber object.
-unsigned int Binary::BinaryNumber::operator&(unsigned int otherNumber)
-{
-	return (this->decimalValue & otherNumber);
-}
-
-// The equivalent decimal value of a bit at a given position (from the least significant)
-// can of course be found from the corresponding power of 2, taking care to account
-// for the fact that the cast from double to int will round down.
-unsigned int Binary::BinaryNumber::DecimalValueOfBitPosition(unsigned int bitPosition)
-{
-	return static_cast<unsigned int>(pow(2, bitPosition) + 0.5);
-}
-
 // Constructor to create a binary number from the equivalent string (e.g. "011010").
-Binary::BinaryNumber::BinaryNumber(std::string binaryNumberAsString)
+Binary::BinaryNumber::BinaryNumber(std::string_view binaryNumberAsString)
 {
-	// Binary numbers of greater than 16 bits can't be guaranteed to fit in an int
 	unsigned int stringLength = binaryNumberAsString.length();
 	assert(stringLength <= maxNumberOfBits);
 
-	// Work from the rightmost character of the string as the 0th bit, moving
-	// left to extract the value of each bit up to the highest value.
+	// Work from the leftmost character of the string as the most significant bit,
+	// shifting everything so far up by one for each new bit.
 	decimalValue = 0;
-	unsigned int bitValue{ 1 };
-	for (int ii = (stringLength - 1); ii >= 0; ii--)
+	for (char bitCharacter : binaryNumberAsString)
 	{
-		if (binaryNumberAsString[ii] == '1')
-		{
-			decimalValue += bitValue;
-		}
-		else
-		{
-			// Just a safety check that the string really does represent a binary
-			// number, any character which is not '1' must be '0'.
-			assert(binaryNumberAsString[ii] == '0');
-		}
-		bitValue <<= 1;
+		// Just a safety check that the string really does represent a binary
+		// number, any character which is not '1' must be '0'.
+		assert((bitCharacter == '1') || (bitCharacter == '0'));
+		decimalValue = (decimalValue << 1) | ((bitCharacter == '1') ? 1 : 0);
 	}
 }
 
-// For a selection of BinaryNumbers of length numBis, return a single BinaryNumber that represents
-// the most common setting of each bit. setOnTie determines whether a given bit will be
-// set or not in the case that exactly half of the BinaryNumber's in the collection
-// have that bit set.
-Binary::BinaryNumber Binary::BinaryNumber::MostCommonBitSettings(
-	std::vector<BinaryNumber> binaryNumbers,
-	bool setOnTie,
-	unsigned int numBits)
+// Invert the first numBits bits of a BinaryNumber, starting from the least significant bit.
+void Binary::BinaryNumber::InvertBits(unsigned int numBits)
 {
-	assert(numBits <= maxNumberOfBits);
-
-	// Build up the new BinaryNumber starting from the least significant bit and
-	// bit-shifting left until we've covered the required number of bits. If a given
-	// bit is more commonly set than not, we add its equivalent decimal value to a
-	// an integer tracking the decimal value of the BinaryNumber formed from the
-	// most common setting of each bit.
-	unsigned int decimalValueOfCommonBits = 0;
-	unsigned int mostSignificantBitValue = DecimalValueOfBitPosition(numBits);
-	unsigned int currentBitInDecimal{ 1 };
-	while (currentBitInDecimal <= mostSignificantBitValue)
+	unsigned int bitMask{ 1 };
+	for (unsigned int bitPosition = 0; bitPosition < numBits; bitPosition++)
 	{
-		// For each BinaryNumber in the list, the bitTracker is either incremented or
-		// decremented depending on whether the current bit being considered is set.
-		// We can then tell whether a given bit was more commonly set than not by
-		// whether the final value of bitTracker is +ve or -ve (remebering to break
-		// ties correctly).
-		int bitTracker = 0;
-		for (BinaryNumber currentNumber : binaryNumbers)
-		{
-			bitTracker += (currentNumber & currentBitInDecimal) ? 1 : -1;
-		}
-		if (bitTracker == 0) { bitTracker = setOnTie ? 1 : -1; }
+		decimalValue ^= bitMask;
+		bitMask <<= 1;
+	}
+}
 
-		if (bitTracker > 0)
-		{
-			decimalValueOfCommonBits += currentBitInDecimal;
-		}
-		currentBitInDecimal <<= 1;
+// Add another number to the report. The first number tells us how many bits every number
+// in the report has, and so how many possible numbers there are to count.
+void Binary::DiagnosticReport::AddBinaryNumber(std::string_view binaryNumberAsString)
+{
+	if (totalNumbers == 0)
+	{
+		numberLength = binaryNumberAsString.length();
+		assert(numberLength <= BinaryNumber::maxNumberOfBits);
+		countsByValue.assign(static_cast<std::size_t>(1) << numberLength, 0);
 	}
+	assert(binaryNumberAsString.length() == numberLength);
 
-	// We've deduced the decimal value of the BinaryNumber formed from the most
-	// common setting of each bit, which we can convert directly into a BinaryNumber
-	// using the right constructor.
-	return BinaryNumber(decimalValueOfCommonBits);
+	countsByValue[BinaryNumber{ binaryNumberAsString }.DecimalValue()]++;
+	totalNumbers++;
 }
 
-// To get the BinaryNumber formed from the least common bit of each BinaryNumber in
-// a collection, we can simply invert each bit in the BinaryNumber formed from the
-// most common setting of each bit.
-Binary::BinaryNumber Binary::BinaryNumber::LeastCommonBitSettings(
-	std::vector<BinaryNumber> numbersToAverageOver,
-	bool setOnTie,
-	unsigned int numBits)
+// Add in every number from another report, as if they'd all been added to this one.
+// Either report can be empty, but otherwise both must be of numbers of the same length.
+void Binary::DiagnosticReport::Merge(DiagnosticReport const& otherReport)
 {
-	// When getting the most common setting of each bit, we need to pass the inverse of our
-	// desired tie break setting, since we will invert every bit in the result.
-	BinaryNumber bitResult = MostCommonBitSettings(numbersToAverageOver, !setOnTie, numBits);
-	bitResult.InvertBits(numBits);
-	return bitResult;
+	if (otherReport.totalNumbers == 0) { return; }
+	if (totalNumbers == 0)
+	{
+		*this = otherReport;
+		return;
+	}
+	assert(numberLength == otherReport.numberLength);
+
+	for (std::size_t value = 0; value < countsByValue.size(); value++)
+	{
+		countsByValue[value] += otherReport.countsByValue[value];
+	}
+	totalNumbers += otherReport.totalNumbers;
 }
 
-// Filter a list of BinaryNumbers down to a single number by iteratively:
-//  - Using the bitMaskCreator to create a bit mask based only on the numbers
-//    not already filtered out of the list by previous iterations.
-//  - Applying the bit mask to create a new list of BinaryNumber's containing
-//    only those numbers which had the same setting as the bitMask for a certain
-//    bit.
-//  - On the first iteration of the filter, this 'certain bit' will be the most
-//    significant bit, on the next iteration it will be the next most significant,
-//    etc.
-//  - Once there is only a single BinaryNumber remaining (the puzzle input guarantees
-//    this will be the case eventually), return that as the result.
-Binary::BinaryNumber Binary::BinaryNumber::IterativeFilterToSingleNumber(
-	Binary::BinaryNumber::BitMaskCreator bitMaskCreator,
-	std::vector<Binary::BinaryNumber> inputLines,
-	bool setOnTie,
-	unsigned int binaryNumberLength)
+// How many numbers in the report lie between firstValue and lastValue, not including
+// lastValue itself.
+ULLINT Binary::DiagnosticReport::CountInRange(unsigned int firstValue, unsigned int lastValue) const
 {
-	// For the first iteration, the bit we care about is the most significant, for
-	// the length of binary number we are dealing with.
-	unsigned int currentIterationSignificantBit = DecimalValueOfBitPosition(binaryNumberLength - 1);
-
-	// For as long as we have more than one binary number left in the list:
-	// - Construct this iteration's bitmask from the numbers remaining in the list, and determine
-	//   whether the bit at the position we are currently interested in is set in that mask.
-	// - Filter the list down to only contain the BinaryNumber's with that bit set or not, as
-	//   required.
-	// - Bitshift our 'bit of interest' to right to get the next most significant bit position
-	//   for our next iteration.
-	do
+	ULLINT count{ 0 };
+	for (unsigned int value = firstValue; value < lastValue; value++)
 	{
-		bool currentBitSet = bitMaskCreator(inputLines, setOnTie, binaryNumberLength) & currentIterationSignificantBit;
-		inputLines = Binary::BinaryNumber::FilterOnBitMask(inputLines, currentBitSet, currentIterationSignificantBit);
-		currentIterationSignificantBit >>= 1;
-	} while (inputLines.size() > 1);
-	return inputLines.front();
+		count += countsByValue[value];
+	}
+	return count;
 }
 
-// Return a new vector of BinaryNumbers filtered from the original vector to contain either:
-//  - In the filter-in case, only those numbers which contain the bitMask
-//  - In the filter-out case, only those numbers which do not contain the bitMask
-std::vector<Binary::BinaryNumber> Binary::BinaryNumber::FilterOnBitMask(
-	std::vector<BinaryNumber> inputList,
-	bool filterIn,
-	unsigned int bitMask)
+// Return a single BinaryNumber that represents the most common setting of each bit across
+// the report, where a bit that's set in exactly half of the numbers counts as set.
+Binary::BinaryNumber Binary::DiagnosticReport::MostCommonBitSettings() const
 {
-	std::vector<BinaryNumber> filteredList;
-	bool matchesMask;
-	for (BinaryNumber currentNumber : inputList)
+	// For each bit, count how many numbers have that bit set. We can then tell whether a
+	// given bit was more commonly set than not by whether it was set in at least half of
+	// the numbers.
+	unsigned int decimalValueOfCommonBits{ 0 };
+	for (unsigned int bitPosition = 0; bitPosition < numberLength; bitPosition++)
 	{
-		matchesMask = (currentNumber & bitMask) == bitMask;
-		if (filterIn ? matchesMask : !matchesMask)
+		unsigned int bitMask = 1 << bitPosition;
+		ULLINT numbersWithBitSet{ 0 };
+		for (unsigned int value = 0; value < countsByValue.size(); value++)
 		{
-			filteredList.push_back(currentNumber);
+			if (value & bitMask) { numbersWithBitSet += countsByValue[value]; }
+		}
+		if ((numbersWithBitSet * 2) >= totalNumbers)
+		{
+			decimalValueOfCommonBits |= bitMask;
 		}
 	}
-	return filteredList;
+	return BinaryNumber(decimalValueOfCommonBits);
 }
 
-// Invert the first numBits bits of a BinaryNumber, starting from the least significant bit.
-void Binary::BinaryNumber::InvertBits(unsigned int numBits)
+// The BinaryNumber formed from the least common bit of each number in the report is just
+// the most common setting of each bit with every bit inverted, which also means a bit
+// that's set in exactly half of the numbers counts as not set.
+Binary::BinaryNumber Binary::DiagnosticReport::LeastCommonBitSettings() const
 {
-	unsigned int bitMask{ 1 };
-	for (unsigned int bitPosition = 0; bitPosition < numBits; bitPosition++)
+	BinaryNumber bitResult = MostCommonBitSettings();
+	bitResult.InvertBits(numberLength);
+	return bitResult;
+}
+
+// Filter the report down to a single number by iteratively:
+//  - Looking at the numbers not already filtered out by previous iterations, working out
+//    whether the bit we're currently considering is more commonly set or not.
+//  - Keeping only those numbers with either the most common or the least common setting
+//    for that bit, as required. Ties are broken in favour of a set bit when keeping the
+//    most common setting, and an unset bit when keeping the least common.
+//  - On the first iteration of the filter, this bit will be the most significant bit,
+//    on the next iteration it will be the next most significant, etc.
+//  - Once there is only a single number remaining (the puzzle input guarantees this will
+//    be the case eventually), return that as the result.
+// The numbers remaining at any point are those starting with the bits we've chosen so far,
+// which is a single range of values. Within that range, those with the next bit unset make
+// up the lower half and those with it set make up the upper half.
+Binary::BinaryNumber Binary::DiagnosticReport::IterativeFilterToSingleNumber(bool keepMostCommon) const
+{
+	assert(totalNumbers > 0);
+	unsigned int rangeStart{ 0 };
+	unsigned int rangeSize = countsByValue.size();
+	ULLINT numbersRemaining = totalNumbers;
+	while ((numbersRemaining > 1) && (rangeSize > 1))
 	{
-		decimalValue ^= bitMask;
-		bitMask <<= 1;
+		rangeSize /= 2;
+		ULLINT numbersWithBitSet = CountInRange(rangeStart + rangeSize, rangeStart + (2 * rangeSize));
+		ULLINT numbersWithBitUnset = numbersRemaining - numbersWithBitSet;
+		bool keepBitSet = keepMostCommon ?
+			(numbersWithBitSet >= numbersWithBitUnset) :
+			(numbersWithBitSet < numbersWithBitUnset);
+
+		// Never filter out every remaining number, even if that means keeping the more
+		// common setting for a bit that none of the remaining numbers differ on.
+		if (numbersWithBitSet == 0) { keepBitSet = false; }
+		if (numbersWithBitUnset == 0) { keepBitSet = true; }
+
+		if (keepBitSet)
+		{
+			rangeStart += rangeSize;
+			numbersRemaining = numbersWithBitSet;
+		}
+		else
+		{
+			numbersRemaining = numbersWithBitUnset;
+		}
 	}
+
+	// Whatever's left is the only number in the range that actually appears in the report.
+	unsigned int value = rangeStart;
+	while (countsByValue[value] == 0) { value++; }
+	return BinaryNumber(value);
 }
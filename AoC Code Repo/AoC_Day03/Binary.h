@@ -1,6 +1,7 @@
 #pragma once
-#include <string>
+#include <string_view>
 #include <vector>
+#include "aoc_common_types.h"
 
 namespace Binary
 {
@@ -10,31 +11,40 @@ namespace Binary
 	{
 	private:
 		unsigned int decimalValue;
-
-		unsigned int operator &(unsigned int otherNumber);
-		static inline unsigned int maxNumberOfBits{ 16 };
-		static unsigned int DecimalValueOfBitPosition(unsigned int bitPosition);
 	public:
+		// Binary numbers of greater than 16 bits can't be guaranteed to fit in an int
+		static constexpr unsigned int maxNumberOfBits{ 16 };
+
 		BinaryNumber(unsigned int decimalValue) : decimalValue(decimalValue) {};
-		BinaryNumber(std::string binaryNumberAsString);
+		BinaryNumber(std::string_view binaryNumberAsString);
 
 		void InvertBits(unsigned int numBits);
 		int DecimalValue() const { return decimalValue; }
+	};
 
-		// The bitMaskCreator function type represents a function capable of returning a single
-		// BinaryNumber based on an inputList of existing BinaryNumbers. setOnTieBreak
-		// will determine the value of any bits in this BinaryNumber which cannot be determined
-		// by whatever rule the bitMaskCreator is applying to deduce the new number.
-		typedef BinaryNumber(*BitMaskCreator)(std::vector<BinaryNumber> inputList, bool setOnTie, unsigned int numBits);
+	// Collects the binary numbers making up the submarine's diagnostic report. Rather than
+	// keeping a list of the numbers, the report just counts how many times each possible
+	// number has appeared, so it takes up the same space however long the report is. Every
+	// number in a report has the same number of bits.
+	// Since the counts are kept in numerical order, all of the numbers starting with a
+	// given set of bits sit next to each other, which is what lets us filter the report
+	// down bit by bit without ever making a filtered copy of it.
+	class DiagnosticReport
+	{
+	private:
+		unsigned int numberLength{ 0 };
+		ULLINT totalNumbers{ 0 };
+		std::vector<ULLINT> countsByValue{};
 
-		static BinaryNumber MostCommonBitSettings(std::vector<BinaryNumber> numbersToAverageOver, bool setOnTie, unsigned int numBits);
-		static BinaryNumber LeastCommonBitSettings(std::vector<BinaryNumber> numbersToAverageOver, bool setOnTie, unsigned int numBits);
-		static std::vector<BinaryNumber> FilterOnBitMask(std::vector<BinaryNumber> inputList, bool bitIsSet, unsigned int bitMask);
+		ULLINT CountInRange(unsigned int firstValue, unsigned int lastValue) const;
+		BinaryNumber IterativeFilterToSingleNumber(bool keepMostCommon) const;
+	public:
+		void AddBinaryNumber(std::string_view binaryNumberAsString);
+		void Merge(DiagnosticReport const& otherReport);
 
-		static BinaryNumber IterativeFilterToSingleNumber(
-			BitMaskCreator bitMask,
-			std::vector<Binary::BinaryNumber> inputLines,
-			bool setOnTie,
-			unsigned int lineLength);
+		BinaryNumber MostCommonBitSettings() const;
+		BinaryNumber LeastCommonBitSettings() const;
+		BinaryNumber OxygenGeneratorRating() const { return IterativeFilterToSingleNumber(true); }
+		BinaryNumber CarbonDioxideScrubberRating() const { return IterativeFilterToSingleNumber(false); }
 	};
-}
\ No newline at end of file
+}
@@ -7,7 +7,7 @@
 // Day 4 presents us with a set of bingo cards and an order in which numbers will be
 // called. We need to find the first and last grid to complete a row or column (and then
 // do a little bit of maths on each of those grids to produce a final couple of numbers).
-PuzzleAnswerPair PuzzleSolvers::AocDayFourSolver(std::ifstream &puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayFourSolver(std::istream& puzzleInputFile)
 {
 	// The first line of input consists of all the bingo numbers which will be called, in
 	// order. Queue these up on our bingo caller and then skip the following blank line
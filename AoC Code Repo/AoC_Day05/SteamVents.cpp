@@ -1,5 +1,6 @@
 #include "SteamVents.h"
-#include <regex>
+#include <algorithm>
+#include <cstdlib>
 #include <cassert>
 #include "Parsing.h"
 
@@ -24,68 +25,50 @@ void Steam::CoordinatePath::OrientPath()
 	}
 }
 
-// Just a couple of simple helpers to get the current width or height of the
-// warning map.
-unsigned int Steam::WarningMap::mapWidth()
+// Count another line crossing a coordinate. Whenever that brings the number of lines
+// that have touched a coordinate to 2, that constitutes the first time an overlap has
+// occured on that position, so increment the total number of overlaps.
+template <typename MapType>
+void Steam::WarningMap<MapType>::MarkLineAt(unsigned int x, unsigned int y)
 {
-	if (map.size() == 0)
-	{
-		return 0;
-	}
-	else
-	{
-		return map[0].size();
-	}
+	unsigned int& linesAtCoordinate = map[{ x, y }].value;
+	linesAtCoordinate++;
+	if (linesAtCoordinate == 2) { numberOfOverlaps++; }
 }
-unsigned int Steam::WarningMap::mapHeight() { return map.size(); }
 
 // Insert a horizontal or vertical line into the WarningMap, incrementing the map's count
 // of overlaps wherever this causes 2 lines to cross the same cell for the first time.
-void Steam::WarningMap::InsertWarningPath(CoordinatePath path)
+template <typename MapType>
+void Steam::WarningMap<MapType>::InsertWarningPath(CoordinatePath path)
 {
 	// This function can only deal with horiztontal or vertical lines, and ensures that
 	// they run from left to right or low to high.
 	assert(!path.IsDiagonalLine());
 	path.OrientPath();
 
-	// If the map isn't already big enough for the coordinates covered by this path, make
-	// it so.
-	MaybeExtendMapSize(path.xFinish + 1, path.yFinish + 1);
-
-	// Work along each coordinate on the line, incrementing the count of number of lines which
-	// have touched each position in the map as we go. Whenever that increment brings the
-	// number of lines that have touched a coordinate to 2, that constitutes the first
-	// time an overlap has occured on that position, so increment the total number of overlaps.
+	// Work along each coordinate on the line, counting the line at each position in the
+	// map as we go.
 	if (path.IsHorizontalLine())
 	{
-		int rowNumber = path.yStart;
 		for (int ii = path.xStart; ii <= path.xFinish; ii++)
 		{
-			map[rowNumber][ii]++;
-			if (map[rowNumber][ii] == 2) { numberOfOverlaps++; }
+			MarkLineAt(ii, path.yStart);
 		}
 	}
 	else if (path.IsVerticalLine())
 	{
-		int columnNumber = path.xStart;
 		for (int ii = path.yStart; ii <= path.yFinish; ii++)
 		{
-			map[ii][columnNumber]++;
-			if (map[ii][columnNumber] == 2) { numberOfOverlaps++; }
+			MarkLineAt(path.xStart, ii);
 		}
 	}
 }
 
 // Insert a diagonal line into the WarningMap, incrementing the map's count
 // of overlaps wherever this causes 2 lines to cross the same cell for the first time.
-void Steam::WarningMap::InsertDiagonalWarningPath(CoordinatePath path)
+template <typename MapType>
+void Steam::WarningMap<MapType>::InsertDiagonalWarningPath(CoordinatePath path)
 {
-	// If the map isn't already big enough for the coordinates covered by this path, make
-	// it so.
-	MaybeExtendMapSize(
-		path.xFinish > path.xStart ? path.xFinish + 1 : path.xStart + 1,
-		path.yFinish > path.yStart ? path.yFinish + 1 : path.yStart + 1);
-
 	// Lines are 45 degrees. Each step along the line will involve either a
 	// step up or down in each direction.
 	int xStep = (path.xFinish > path.xStart) ? 1 : -1;
@@ -93,37 +76,35 @@ void Steam::WarningMap::InsertDiagonalWarningPath(CoordinatePath path)
 	int lineLength = abs(path.xFinish - path.xStart);
 
 	// Step along the line from its start, using the steps we just calculated, until we've
-	// made as many steps as required to finish the line. Increment the count of number
-	// of lines which have touched each position in the map as we go. Whenever that increment
-	// brings the number of lines that have touched a coordinate to 2, that constitutes the first
-	// time an overlap has occured on that position, so increment the total number of overlaps.
+	// made as many steps as required to finish the line, counting the line at each
+	// position in the map as we go.
 	for (int ii = 0; ii <= lineLength; ii++)
 	{
-		map[path.yStart + (yStep * ii)][path.xStart + (xStep * ii)]++;
-		if (map[path.yStart + (yStep * ii)][path.xStart + (xStep * ii)] == 2)
-		{
-			numberOfOverlaps++;
-		}
+		MarkLineAt(path.xStart + (xStep * ii), path.yStart + (yStep * ii));
 	}
 }
 
-// Given a required width and height, extend the map in either or both of those
-// directions to ensure it can provide that width and height if it doesn't already.
-// It would probably be more efficient to work out how big a map we need in the
-// first place, but this doesn't seem to be costing us too much, so I'm happy enough
-// for now.
-void Steam::WarningMap::MaybeExtendMapSize(unsigned int width, unsigned int height)
+// Find the extent of a set of lines, ready to choose a map for them.
+Steam::LineExtent Steam::MeasureLines(std::vector<CoordinatePath> const& paths)
 {
-	if (height > mapHeight())
+	LineExtent extent{};
+	for (CoordinatePath const& path : paths)
 	{
-		map.resize(height);
+		extent.width = std::max({ extent.width, static_cast<unsigned int>(path.xStart) + 1, static_cast<unsigned int>(path.xFinish) + 1 });
+		extent.height = std::max({ extent.height, static_cast<unsigned int>(path.yStart) + 1, static_cast<unsigned int>(path.yFinish) + 1 });
+		extent.coordinatesOnLines += std::max(std::abs(path.xFinish - path.xStart), std::abs(path.yFinish - path.yStart)) + 1;
 	}
+	return extent;
+}
 
-	for (std::vector<int> &row : map)
-	{
-		if (width > row.size())
-		{
-			row.resize(width, 0);
-		}
-	}
+// A dense map has to cover every coordinate from the origin out to the furthest line,
+// whereas a sparse map only holds the coordinates the lines actually cross, so which is
+// better depends on how spread out the lines are.
+bool Steam::LineExtent::DenseMapIsWorthwhile() const
+{
+	std::size_t denseMapBytes = static_cast<std::size_t>(width) * height * sizeof(unsigned int);
+	return GridUtils::DenseStorageIsWorthwhile<unsigned int>(denseMapBytes, coordinatesOnLines);
 }
+
+template class Steam::WarningMap<GridUtils::Grid<unsigned int>>;
+template class Steam::WarningMap<GridUtils::SparseGrid<unsigned int>>;
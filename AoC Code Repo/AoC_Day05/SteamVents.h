@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "grid_utils.h"
 
 namespace Steam
 {
@@ -19,20 +20,39 @@ namespace Steam
 		bool IsDiagonalLine() const { return !(IsHorizontalLine() || IsVerticalLine()); }
 	};
 
-	// The warning map is a growable map of coordinates, into which lines between given
+	// The warning map is a map of coordinates, into which lines between given
 	// coordinates can be inserted. The map will keep track of the number of coordinates
 	// which have at least 2 lines overlapping on them, which can be queried.
+	// The count of lines at each coordinate can be held in any grid that's read and written
+	// through map[coord].value, so either a dense GridUtils::Grid big enough for every line,
+	// or a GridUtils::SparseGrid holding just the coordinates that lines actually cross.
+	template <typename MapType>
 	class WarningMap
 	{
 	private:
-		std::vector<std::vector<int>> map;
-		unsigned int mapWidth();
-		unsigned int mapHeight();
+		MapType map;
 		unsigned int numberOfOverlaps{ 0 };
+		void MarkLineAt(unsigned int x, unsigned int y);
 	public:
+		WarningMap(MapType mapIn) : map{ std::move(mapIn) } {};
 		void InsertWarningPath(CoordinatePath path);
 		void InsertDiagonalWarningPath(CoordinatePath path);
 		unsigned int NumberOfOverlapCells() const { return numberOfOverlaps; }
-		void MaybeExtendMapSize(unsigned int width, unsigned int height);
 	};
+
+	// How far a set of lines spreads out from the origin, and how many coordinates they
+	// cross between them (counting a coordinate again for every line that crosses it). From
+	// this we can tell which of the two kinds of map the lines should be inserted into.
+	struct LineExtent
+	{
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+		std::size_t coordinatesOnLines{ 0 };
+
+		bool DenseMapIsWorthwhile() const;
+	};
+	LineExtent MeasureLines(std::vector<CoordinatePath> const& paths);
+
+	using DenseWarningMap = WarningMap<GridUtils::Grid<unsigned int>>;
+	using SparseWarningMap = WarningMap<GridUtils::SparseGrid<unsigned int>>;
 }
\ No newline at end of file
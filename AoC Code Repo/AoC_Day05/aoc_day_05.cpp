@@ -4,53 +4,75 @@
 #include "puzzle_solvers.h"
 #include "Parsing.h"
 
-// Day 5 presents us with a whole bunch of lines given in the form "x1,y1 -> x2,y2",
-// and ask us to calculate the number of coordinates which contain overlapping lines.
-// Part 1 ignores all diagonal lines from the input, while part 2 takes the diagonal
-// lines into account too.
-PuzzleAnswerPair PuzzleSolvers::AocDayFiveSolver(std::ifstream &puzzleInputFile)
+namespace
 {
-	Steam::WarningMap warningMap;
-	std::vector<Steam::CoordinatePath> diagonalLines;
+	// Each line of the input is in the form "x1,y1 -> x2,y2".
+	using CoordinatePathRecord = Parsing::Record<
+		Parsing::Int, Parsing::Sep<','>, Parsing::Int,
+		Parsing::Lit<" -> ">,
+		Parsing::Int, Parsing::Sep<','>, Parsing::Int>;
 
-	// Parse every line from the puzzle input into the constituent coordinates of
-	// its start and end position. For non-diagonal lines, insert them into the
-	// overall 'map' of lines (map in the sense that it holds a 2D grid of coordinates,
-	// not a map in the STL sense) as we go. Put diagonal lines to the side to add to
-	// the map during part 2.
-	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
-	std::regex matchString{ "([0-9]+),([0-9]+) -> ([0-9]+),([0-9]+)" };
-	for (std::string inputLine : inputLines)
+	// Insert the lines into the map, non-diagonal lines first and then diagonal ones,
+	// returning the number of overlaps after each.
+	template <typename MapType>
+	PuzzleAnswerPair OverlapsOnMap(std::vector<Steam::CoordinatePath> const& coordPaths, Steam::WarningMap<MapType> warningMap)
 	{
-		Steam::CoordinatePath coordPath;
-		Parsing::ParseStringIntoElements(
-			inputLine,
-			matchString,
-			coordPath.xStart,
-			coordPath.yStart,
-			coordPath.xFinish,
-			coordPath.yFinish);
-		if (!coordPath.IsDiagonalLine())
+		// Insert every non-diagonal line into the overall 'map' of lines (map in the sense
+		// that it holds a 2D grid of coordinates, not a map in the STL sense) first.
+		for (Steam::CoordinatePath const& coordPath : coordPaths)
 		{
-			warningMap.InsertWarningPath(coordPath);
+			if (!coordPath.IsDiagonalLine())
+			{
+				warningMap.InsertWarningPath(coordPath);
+			}
 		}
-		else
+
+		// The solution to part 1 is the number of coordinates in the map which have
+		// overlapping lines after taking into account all non-diagonal lines.
+		unsigned int overlapsWithoutDiagonals = warningMap.NumberOfOverlapCells();
+
+		// Then for part 2 we just add in all of the diagonal lines, and re-query the number
+		// of coordinates with overlapping lines.
+		for (Steam::CoordinatePath const& coordPath : coordPaths)
 		{
-			diagonalLines.push_back(coordPath);
+			if (coordPath.IsDiagonalLine())
+			{
+				warningMap.InsertDiagonalWarningPath(coordPath);
+			}
 		}
+		unsigned int overlapsIncludingDiagonals = warningMap.NumberOfOverlapCells();
+
+		return PuzzleAnswerPair{ std::to_string(overlapsWithoutDiagonals), std::to_string(overlapsIncludingDiagonals) };
 	}
+}
 
-	// The solution to part 1 is the number of coordinates in the map which have
-	// overlapping lines after taking into account all non-diagonal lines.
-	unsigned int overlapsWithoutDiagonals = warningMap.NumberOfOverlapCells();
+// Day 5 presents us with a whole bunch of lines given in the form "x1,y1 -> x2,y2",
+// and ask us to calculate the number of coordinates which contain overlapping lines.
+// Part 1 ignores all diagonal lines from the input, while part 2 takes the diagonal
+// lines into account too.
+PuzzleAnswerPair PuzzleSolvers::AocDayFiveSolver(std::istream& puzzleInputFile)
+{
+	// Parse every line from the puzzle input into the constituent coordinates of
+	// its start and end position.
+	// Lines are parsed independently of each other, so a large input is split up and
+	// parsed in parallel, before being inserted into the map in order.
+	std::string inputStorage{};
+	std::string_view inputText = PuzzleInput::RemainingText(puzzleInputFile, inputStorage);
+	std::vector<Steam::CoordinatePath> coordPaths = PuzzleInput::ParseLinesInParallel<Steam::CoordinatePath>(
+		inputText,
+		[](std::string_view inputLine)
+		{
+			Steam::CoordinatePath coordPath;
+			CoordinatePathRecord::ParseValidInto(inputLine, coordPath);
+			return coordPath;
+		});
 
-	// Then for part 2 we just add in all of the diagonal lines we set aside earlier,
-	// and re-query the number of coordinates with overlapping lines.
-	for (Steam::CoordinatePath path : diagonalLines)
+	// With every line known up front, the map can be made the right size straight away, or
+	// if the lines are spread thinly over a wide area, made sparse instead.
+	Steam::LineExtent lineExtent = Steam::MeasureLines(coordPaths);
+	if (lineExtent.DenseMapIsWorthwhile())
 	{
-		warningMap.InsertDiagonalWarningPath(path);
+		return OverlapsOnMap(coordPaths, Steam::DenseWarningMap{ GridUtils::Grid<unsigned int>{ lineExtent.width, lineExtent.height, 0 } });
 	}
-	unsigned int overlapsIncludingDiagonals = warningMap.NumberOfOverlapCells();
-
-	return PuzzleAnswerPair{ std::to_string(overlapsWithoutDiagonals), std::to_string(overlapsIncludingDiagonals) };
+	return OverlapsOnMap(coordPaths, Steam::SparseWarningMap{ GridUtils::SparseGrid<unsigned int>{ lineExtent.coordinatesOnLines } });
 }
\ No newline at end of file
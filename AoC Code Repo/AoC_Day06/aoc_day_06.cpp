@@ -1,35 +1,51 @@
 #include "LanternFish.h"
+#include <string>
 #include "Parsing.h"
-#include <iostream>
-#include <vector>
 #include "puzzle_solvers.h"
 
+namespace
+{
+	// Puzzle input is a comma separated list of how many days each current lanternfish
+	// will take to produce a new one. Each is fed into the tracker as soon as it's read, so
+	// however many lanternfish we start with, all we ever hold is the tracker's buckets.
+	class LanternFishSolver
+	{
+	public:
+		static constexpr std::string_view recordDelimiters{ ",\r\n" };
+
+		void ConsumeRecord(std::string_view record)
+		{
+			int lanternFishDaysToBirth = Parsing::ConvertValidNumber<int>(record);
+			lanternFishTracker.AddALanternFish(lanternFishDaysToBirth);
+		}
+
+		// The puzzle requires us to determine the number of lanternfish after 80 days and after 256
+		// days total.
+		PuzzleAnswerPair Answers()
+		{
+			PuzzleAnswerPair answer;
+			lanternFishTracker.DaysHavePassed(80);
+			answer.first = std::to_string(lanternFishTracker.TotalNumberOfLanterFish());
+			lanternFishTracker.DaysHavePassed(176);
+			answer.second = std::to_string(lanternFishTracker.TotalNumberOfLanterFish());
+			return answer;
+		}
+
+	private:
+		LanternFish::LanternFishTracker lanternFishTracker;
+	};
+}
+
 // Day six covers an exponentially growing population of lanternfish. We start with a bunch
 // of lanternfish of various ages, and the knowledge that each lanternfish will produce a
 // new lanternfish every 7 days. Based on the initial collection of lanternfish, we need
 // to find out how many there will be after first 80 and the 256 days.
-PuzzleAnswerPair PuzzleSolvers::AocDaySixSolver(std::ifstream &puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDaySixSolver(PuzzleInput::MappedFile const& puzzleInput)
 {
-	// Puzzle input is a comma separated list of how many days each current lanternfish
-	// will take to produce a new one.
-	std::vector<int> lanternFishInput =
-		Parsing::SplitNextLineOnDelimiter<int>(puzzleInputFile, Parsing::comma);
-
-	// Feed this initial collection of lanternfish tracker ready to start incrementing
-	// days.
-	LanternFish::LanternFishTracker lanternFishTracker;
-	for (int lantenFishDaysToBirth : lanternFishInput)
-	{
-		lanternFishTracker.AddALanternFish(lantenFishDaysToBirth);
-	}
-
-	// The puzzle requires us to determine the number of lanternfish after 80 days and after 256
-	// days total.
-	PuzzleAnswerPair answer;
-	lanternFishTracker.DaysHavePassed(80);
-	answer.first = std::to_string(lanternFishTracker.TotalNumberOfLanterFish());
-	lanternFishTracker.DaysHavePassed(176);
-	answer.second = std::to_string(lanternFishTracker.TotalNumberOfLanterFish());
+	return SolveMappedInput<LanternFishSolver>(puzzleInput);
+}
 
-	return answer;
-}
\ No newline at end of file
+PuzzleAnswerPair PuzzleSolvers::AocDaySixStreamingSolver(std::istream& puzzleInputStream)
+{
+	return SolveInputStream<LanternFishSolver>(puzzleInputStream);
+}
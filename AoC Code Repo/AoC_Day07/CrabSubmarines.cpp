@@ -119,7 +119,7 @@ void CrabSubmarines::CrabArmada::AddCrabSumbarine(unsigned int position)
 // In part one, the cost for each crab submarine to move to a position is simply the difference
 // between its current position and the convergence position. 
 // Find the minimum cost for all submarines to converge on a single point under these rules.
-unsigned int CrabSubmarines::CrabArmada::PartOneMinimalConvergenceCost() const
+ULLINT CrabSubmarines::CrabArmada::PartOneMinimalConvergenceCost() const
 {
 	// First find the optimal convergence position, which will require the least fuel
 	// for all crabs to move there under the part one fuel consumption rules.
@@ -127,10 +127,10 @@ unsigned int CrabSubmarines::CrabArmada::PartOneMinimalConvergenceCost() const
 
 	// The total cost to converge is then just the sum of the differences between each
 	// crab's position and the convergence position.
-	unsigned int movementRequiredToConverge{ 0 };
+	ULLINT movementRequiredToConverge{ 0 };
 	for (unsigned int ii = 0; ii < crabsByPosition.size(); ii++)
 	{
-		movementRequiredToConverge += crabsByPosition[ii] * abs((int)ii - medianPosition);
+		movementRequiredToConverge += static_cast<ULLINT>(crabsByPosition[ii]) * abs((int)ii - medianPosition);
 	}
 	return movementRequiredToConverge;
 }
@@ -140,7 +140,7 @@ unsigned int CrabSubmarines::CrabArmada::PartOneMinimalConvergenceCost() const
 // first step taken costs 1, the next step costs 2 etc.
 // Find the minimum cost to converge all submarines to a single position under
 // these rules.
-unsigned int CrabSubmarines::CrabArmada::PartTwoMinimalConvergenceCost() const
+ULLINT CrabSubmarines::CrabArmada::PartTwoMinimalConvergenceCost() const
 {
 	// First find the optimal convergence position, which will require the least fuel
 	// for all crabs to move there under the part two fuel consumption rules.
@@ -150,11 +150,11 @@ unsigned int CrabSubmarines::CrabArmada::PartTwoMinimalConvergenceCost() const
 	// where n is the total number of steps we need to move. So our cost to move from
 	// one position to another is the sum of an arithmetic sequence of n steps, where
 	// the first number in the sequence is 1 and the nth is n.
-	int movementRequiredToConverge{ 0 };
+	ULLINT movementRequiredToConverge{ 0 };
 	for (unsigned int ii = 0; ii < crabsByPosition.size(); ii++)
 	{
-		unsigned int spacesToMove = abs((int)ii - positionToMoveTo);
-		int movementCost = spacesToMove * (spacesToMove + 1) / 2;
+		ULLINT spacesToMove = abs((int)ii - positionToMoveTo);
+		ULLINT movementCost = spacesToMove * (spacesToMove + 1) / 2;
 		movementRequiredToConverge += movementCost * crabsByPosition[ii];
 	}
 	return movementRequiredToConverge;
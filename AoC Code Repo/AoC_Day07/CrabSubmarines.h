@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include "aoc_common_types.h"
 
 namespace CrabSubmarines
 {
@@ -9,6 +10,7 @@ namespace CrabSubmarines
 	// on a single point, where the armada will select the point to converge on as
 	// being that with the lowest associated total fuel cost. There are two different
 	// rules of fuel consumption that can be used when finding this minimal convergence.
+	// Costs are 64 bit, since the part 2 cost grows with the square of the distance moved.
 	class CrabArmada
 	{
 	private:
@@ -24,7 +26,7 @@ namespace CrabSubmarines
 		unsigned int PartTwoOptimalConvergencePosition() const;
 	public:
 		void AddCrabSumbarine(unsigned int position);
-		unsigned int PartOneMinimalConvergenceCost() const;
-		unsigned int PartTwoMinimalConvergenceCost() const;
+		ULLINT PartOneMinimalConvergenceCost() const;
+		ULLINT PartTwoMinimalConvergenceCost() const;
 	};
 }
\ No newline at end of file
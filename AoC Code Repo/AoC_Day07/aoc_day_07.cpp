@@ -1,32 +1,52 @@
-#include "Parsing.h"
 #include "CrabSubmarines.h"
-#include <iostream>
+#include <string>
+#include "Parsing.h"
 #include "puzzle_solvers.h"
 
+namespace
+{
+	// Puzzle input is a comma separated list of initial crab submarine positions. The armada
+	// only counts how many submarines are at each position, so each submarine can be added
+	// as soon as it's read, and the armada only grows with the range of positions rather
+	// than with the number of submarines.
+	class CrabArmadaSolver
+	{
+	public:
+		static constexpr std::string_view recordDelimiters{ ",\r\n" };
+
+		void ConsumeRecord(std::string_view record)
+		{
+			unsigned int crabPosition = Parsing::ConvertValidNumber<unsigned int>(record);
+			crabArmada.AddCrabSumbarine(crabPosition);
+		}
+
+		// The puzzle requires us to find the position that the crabs could all move
+		// to with the least collective fuel, and then return how many units of fuel
+		// that convergence would cost. The rules for fuel consumption are different
+		// between part 1 and part 2.
+		PuzzleAnswerPair Answers() const
+		{
+			return PuzzleAnswerPair{
+				std::to_string(crabArmada.PartOneMinimalConvergenceCost()),
+				std::to_string(crabArmada.PartTwoMinimalConvergenceCost()) };
+		}
+
+	private:
+		CrabSubmarines::CrabArmada crabArmada;
+	};
+}
+
 // Day 7 gives us a list of positions of "crab submarines", and asks us to find the position
 // that all of these submarines could move to using the least amount of collective fuel.
 // In part 1, the rule for fuel consumption is simply that each space moved costs 1 unit of
 // fuel. In part 2, the amount of fuel required for each step increases the further a submarine
 // moves from its starting position.
-PuzzleAnswerPair PuzzleSolvers::AocDaySevenSolver(std::ifstream &puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDaySevenSolver(PuzzleInput::MappedFile const& puzzleInput)
 {
-	// Puzzle input is a comma separated list of initial crab submarine positions.
-	std::vector<int> crabPositionList =
-		Parsing::SplitNextLineOnDelimiter<int>(puzzleInputFile, Parsing::comma);
+	return SolveMappedInput<CrabArmadaSolver>(puzzleInput);
+}
 
-	// Create our armada of crab submarines, inserting a submarine at each position
-	// specified by the puzzle input.
-	CrabSubmarines::CrabArmada crabArmada;
-	for (int crabPosition : crabPositionList)
-	{
-		crabArmada.AddCrabSumbarine(crabPosition);
-	}
-
-	// The puzzle requires us to find the position that the crabs could all move
-	// to with the least collective fuel, and then return how many units of fuel
-	// that convergence would cost. The rules for fuel consumption are different
-	// between part 1 and part 2.
-	return PuzzleAnswerPair{
-		std::to_string(crabArmada.PartOneMinimalConvergenceCost()),
-		std::to_string(crabArmada.PartTwoMinimalConvergenceCost()) };
-}
\ No newline at end of file
+PuzzleAnswerPair PuzzleSolvers::AocDaySevenStreamingSolver(std::istream& puzzleInputStream)
+{
+	return SolveInputStream<CrabArmadaSolver>(puzzleInputStream);
+}
@@ -1,126 +1,176 @@
 #include "Heightmap.h"
-#include <unordered_set>
-#include <set>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <functional>
+#include <numeric>
+#include <thread>
 
-// A location is a low point if the height of the adjacent cells in every cardinal direction
-// is greater than itself.
-bool HeightMap::HeightMap::LocationIsLowPoint(GridUtils::Grid<int>::GridCell location) const
+namespace
 {
-	bool northHigher, southHigher, eastHigher, westHigher;
-	int locationHeight = location.value;
-	northHigher = location.IsTopRow() ?
-		true : location.Up().value > locationHeight;
-	southHigher = (location.IsBottomRow()) ?
-		true : location.Down().value > locationHeight;
-	eastHigher = location.IsRightColumn() ?
-		true : location.Right().value > locationHeight;
-	westHigher = location.IsLeftColumn() ?
-		true : location.Left().value > locationHeight;
+	using TiledHeights = GridUtils::TiledGrid<std::uint8_t>;
+	using TiledLabels = GridUtils::TiledGrid<unsigned int>;
+	constexpr unsigned int notInBasin{ UINT_MAX };
 
-	return (northHigher && southHigher && eastHigher && westHigher) ?
-		true : false;
-}
+	// Finding the low points of a large map is split into bands of rows, each on its own
+	// thread, but starting a thread isn't worth it for fewer rows than this.
+	constexpr unsigned int minRowsPerBand{ 256 };
 
-// From a given low point, find the size of the basin the low point resides in, where a
-// basin includes all cells up to (but not including) a cell with a height of 9, or the
-// edge of the map.
-// Calculates the basin size using a breadth-first-search-esque expansion from the low
-// point.
-int HeightMap::HeightMap::GetBasinSize(GridUtils::Grid<int>::GridCell lowPoint) const
-{
-	auto coordHash = [](GridUtils::Grid<int>::GridCell const & coord) -> size_t { return coord.GetCoordinate().xPos; };
-	std::unordered_set<GridUtils::Grid<int>::GridCell, decltype(coordHash)> exploredPositions{ 0, coordHash };
-	std::vector<GridUtils::Grid<int>::GridCell> positionsToExploreFrom{ lowPoint };
-	
-	// We start off with a single position to explore from, our starting low point. On each
-	// loop we get the next position to explore from and look in each cardinal direction. If
-	// there is a cell in that direction (i.e. not the edge of the map) which is neither height
-	// 9 nor already explored, add that cell to the list of positions we still need to explore
-	// from. If we do this until there are no unexplored cells left we will have found the size
-	// of the basin bounded be map-edge and/or height-9 cells.
-	while (positionsToExploreFrom.size() > 0)
+	// Label the parts of basins lying within a single tile, by flood filling from each
+	// location that's not yet labelled. Every location in one part gets the same label,
+	// which is where the first of them is held in the tiled grid, so no two tiles ever use
+	// the same label. The size of each part is noted against its label.
+	void LabelBasinPartsOfTile(
+		TiledHeights::ConstTile heights,
+		TiledLabels::Tile labels,
+		std::uint8_t basinEdgeHeight,
+		std::vector<unsigned int>& partSizes)
 	{
-		GridUtils::Grid<int>::GridCell positionToExploreFrom = positionsToExploreFrom.back();
-		positionsToExploreFrom.pop_back();
-
-		if (!(positionToExploreFrom.IsRightColumn() || (positionToExploreFrom.Right().value == 9)))
+		std::vector<GridUtils::Coordinate> positionsToExploreFrom{};
+		for (unsigned int y = 0; y < heights.Height(); y++)
 		{
-			if (exploredPositions.find(positionToExploreFrom.Right()) == exploredPositions.end())
+			for (unsigned int x = 0; x < heights.Width(); x++)
 			{
-				positionsToExploreFrom.push_back(positionToExploreFrom.Right());
+				if ((heights[{ x, y }] == basinEdgeHeight) || (labels[{ x, y }] != notInBasin)) { continue; }
+
+				unsigned int label = static_cast<unsigned int>((heights.Index() * TiledHeights::cellsPerTile) + (y * TiledHeights::tileSize) + x);
+				unsigned int partSize{ 0 };
+				labels[{ x, y }] = label;
+				positionsToExploreFrom.push_back({ x, y });
+				while (!positionsToExploreFrom.empty())
+				{
+					GridUtils::Coordinate position = positionsToExploreFrom.back();
+					positionsToExploreFrom.pop_back();
+					partSize++;
+
+					auto exploreTo = [&](unsigned int nextX, unsigned int nextY)
+					{
+						if ((heights[{ nextX, nextY }] != basinEdgeHeight) && (labels[{ nextX, nextY }] == notInBasin))
+						{
+							labels[{ nextX, nextY }] = label;
+							positionsToExploreFrom.push_back({ nextX, nextY });
+						}
+					};
+					if (position.xPos > 0) { exploreTo(position.xPos - 1, position.yPos); }
+					if ((position.xPos + 1) < heights.Width()) { exploreTo(position.xPos + 1, position.yPos); }
+					if (position.yPos > 0) { exploreTo(position.xPos, position.yPos - 1); }
+					if ((position.yPos + 1) < heights.Height()) { exploreTo(position.xPos, position.yPos + 1); }
+				}
+				partSizes[label] = partSize;
 			}
 		}
-		if (!(positionToExploreFrom.IsLeftColumn() || (positionToExploreFrom.Left().value == 9)))
+	}
+
+	// Keeps track of which basin parts have been found to join up into the same basin, with
+	// each basin represented by the label of one of its parts.
+	class BasinParts
+	{
+	private:
+		std::vector<unsigned int> joinedTo;
+	public:
+		BasinParts(std::size_t numberOfLabels) : joinedTo(numberOfLabels)
 		{
-			if (exploredPositions.find(positionToExploreFrom.Left()) == exploredPositions.end())
-			{
-				positionsToExploreFrom.push_back(positionToExploreFrom.Left());
-			}
+			std::iota(joinedTo.begin(), joinedTo.end(), 0);
 		}
-		if (!(positionToExploreFrom.IsTopRow() || (positionToExploreFrom.Up().value == 9)))
+
+		unsigned int BasinOf(unsigned int label)
 		{
-			if (exploredPositions.find(positionToExploreFrom.Up()) == exploredPositions.end())
+			while (joinedTo[label] != label)
 			{
-				positionsToExploreFrom.push_back(positionToExploreFrom.Up());
+				joinedTo[label] = joinedTo[joinedTo[label]];
+				label = joinedTo[label];
 			}
+			return label;
 		}
-		if (!(positionToExploreFrom.IsBottomRow() || (positionToExploreFrom.Down().value == 9)))
+
+		void Join(unsigned int firstLabel, unsigned int secondLabel)
 		{
-			if (exploredPositions.find(positionToExploreFrom.Down()) == exploredPositions.end())
-			{
-				positionsToExploreFrom.push_back(positionToExploreFrom.Down());
-			}
+			joinedTo[BasinOf(secondLabel)] = BasinOf(firstLabel);
 		}
-
-		exploredPositions.insert(positionToExploreFrom);
-	}
-	return exploredPositions.size();
+	};
 }
 
 // The 'risk level' of a point is defined as its height plus one.
 // Part 1 of the puzzle requires us to sum up the risk levels of all low
-// points. This function is non-const in the way it calculates this, since
-// it will also cache the list of low points discovered in this way for
-// the basin calculations in part 2.
-int HeightMap::HeightMap::SumLowPointRiskLevels()
+// points.
+// A location is a low point if the height of the adjacent cells in every cardinal direction
+// is greater than itself. These are all found in one pass over the map with a stencil,
+// where the map is surrounded by a halo of maximum height so that the edge of the map
+// never stops a location from being a low point. On a large map, the rows are split into
+// bands which are searched for low points in parallel.
+ULLINT HeightMap::HeightMap::SumLowPointRiskLevels() const
 {
-	int sumOfRiskLevels{ 0 };
-	
-	for (auto itr = heightMap.begin(); itr != heightMap.end(); itr++)
+	GridUtils::PaddedGrid<std::uint8_t> paddedHeights{ heightMap, UINT8_MAX };
+	GridUtils::PaddedGrid<std::uint8_t> isLowPoint{ heightMap.Width(), heightMap.Height(), 0 };
+	unsigned int rowBands = std::clamp(heightMap.Height() / minRowsPerBand, 1u, std::max(1u, std::thread::hardware_concurrency()));
+	GridUtils::StrictLocalMinima(paddedHeights, isLowPoint, GridUtils::Neighbourhood::FourNeighbours, rowBands);
+
+	ULLINT sumOfRiskLevels{ 0 };
+	for (unsigned int y = 0; y < heightMap.Height(); y++)
 	{
-		auto location = *itr;
-		if (LocationIsLowPoint(location))
+		std::uint8_t const* lowPointRow = isLowPoint.Row(y);
+		for (unsigned int x = 0; x < heightMap.Width(); x++)
 		{
-			sumOfRiskLevels += location.value + 1;
-			lowPoints.push_back(location);
+			if (lowPointRow[x])
+			{
+				sumOfRiskLevels += heightMap[{ x, y }].value + 1;
+			}
 		}
 	}
 	return sumOfRiskLevels;
 }
 
 // For part 2, we need to find the 3 largest basins, and return the product
-// of their sizes. For this we use the list of low points calculated by part
-// 1, and the knowledge that every basin contains exactly one low point.
-int HeightMap::HeightMap::ProductOfLargestBasins() const
+// of their sizes.
+// The map is split into tiles, and the parts of basins within each tile are found
+// separately, with the tiles shared out between threads. Basins that cross from one tile
+// into the next are then pieced together by looking along the edges between tiles for
+// basin locations next to each other, joining up the parts either side.
+ULLINT HeightMap::HeightMap::ProductOfLargestBasins() const
 {
-	// Start by finding the size of every basin. Every basin contains exactly one
-	// low point, so we can simply find the basin that each of our low points resides
-	// in, and be sure that we will neither miss or double count any basin.
-	std::set<unsigned int> basinSizes{};
-	for (auto const &lowPoint : lowPoints)
+	TiledHeights const heights{ heightMap };
+	TiledLabels labels{ heights.Width(), heights.Height(), notInBasin };
+	std::vector<unsigned int> partSizes(labels.NumberOfTiles() * TiledLabels::cellsPerTile, 0);
+	unsigned int numberOfThreads = std::min(labels.NumberOfTiles(), std::max(1u, std::thread::hardware_concurrency()));
+	labels.ForEachTile([&](TiledLabels::Tile labelTile)
+		{
+			LabelBasinPartsOfTile(heights.GetTile(labelTile.Index()), labelTile, basinEdgeHeight, partSizes);
+		}, numberOfThreads);
+
+	BasinParts basinParts{ partSizes.size() };
+	auto joinIfBothInBasins = [&](GridUtils::Coordinate first, GridUtils::Coordinate second)
+	{
+		if ((labels[first] != notInBasin) && (labels[second] != notInBasin)) { basinParts.Join(labels[first], labels[second]); }
+	};
+	for (unsigned int x = TiledLabels::tileSize; x < labels.Width(); x += TiledLabels::tileSize)
+	{
+		for (unsigned int y = 0; y < labels.Height(); y++) { joinIfBothInBasins({ x - 1, y }, { x, y }); }
+	}
+	for (unsigned int y = TiledLabels::tileSize; y < labels.Height(); y += TiledLabels::tileSize)
+	{
+		for (unsigned int x = 0; x < labels.Width(); x++) { joinIfBothInBasins({ x, y - 1 }, { x, y }); }
+	}
+
+	// Add up the size of every basin from the sizes of its parts.
+	std::vector<unsigned int> sizeOfBasin(partSizes.size(), 0);
+	for (unsigned int label = 0; label < partSizes.size(); label++)
+	{
+		if (partSizes[label] > 0) { sizeOfBasin[basinParts.BasinOf(label)] += partSizes[label]; }
+	}
+	std::vector<unsigned int> basinSizes{};
+	for (unsigned int basinSize : sizeOfBasin)
 	{
-		int basinSize = GetBasinSize(lowPoint);
-		basinSizes.insert(basinSize);
+		if (basinSize > 0) { basinSizes.push_back(basinSize); }
 	}
 
-	// Our basin sizes were listed in order by the previous step, so just take
-	// the back 3 elements of the list.
-	int productOfTopThree{ 1 };
-	auto iter = basinSizes.rbegin();
+	// Two basins can be the same size, so every size is kept rather than just the distinct
+	// ones, and only the front 3 elements need putting in order, largest first.
+	assert(basinSizes.size() >= 3);
+	std::partial_sort(basinSizes.begin(), basinSizes.begin() + 3, basinSizes.end(), std::greater<unsigned int>{});
+	ULLINT productOfTopThree{ 1 };
 	for (int ii = 0; ii < 3; ii++)
 	{
-		productOfTopThree *= *iter;
-		iter++;
+		productOfTopThree *= basinSizes[ii];
 	}
 	return productOfTopThree;
 }
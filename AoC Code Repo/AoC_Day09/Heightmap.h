@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include "grid_utils.h"
+#include "Parsing.h"
 
 namespace HeightMap
 {
@@ -13,17 +15,15 @@ namespace HeightMap
 	private:
 		// My custom GridUtils library is used to make working with a grid of integers
 		// easier.
-		GridUtils::Grid<int> heightMap;
+		GridUtils::Grid<std::uint8_t> heightMap;
 
 		// The key features of the height map are low points (defined as points which are
 		// lower than all of their adjacent points) and basins (regions of the map which are
 		// completed bounded by a mix of height-9 points and the edge of the map).
-		std::vector<GridUtils::Grid<int>::GridCell> lowPoints{};
-		bool LocationIsLowPoint(GridUtils::Grid<int>::GridCell location) const;
-		int GetBasinSize(GridUtils::Grid<int>::GridCell coordinate) const;
+		static constexpr std::uint8_t basinEdgeHeight{ 9 };
 	public:
-		HeightMap(std::vector<std::vector<int>> heightMap) : heightMap{ heightMap } {};
-		int SumLowPointRiskLevels();
-		int ProductOfLargestBasins() const;
+		HeightMap(Parsing::DigitGrid heights) : heightMap{ std::move(heights.digits), heights.width } {};
+		ULLINT SumLowPointRiskLevels() const;
+		ULLINT ProductOfLargestBasins() const;
 	};
 }
\ No newline at end of file
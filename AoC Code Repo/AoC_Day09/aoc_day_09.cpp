@@ -7,11 +7,9 @@
 // and sum up the heights of these low points.
 // Part two requires us to find the largest basin (area surrounded by height-9 locations or
 // cavern edges), and do a product of all the individual heights within than basin.
-PuzzleAnswerPair PuzzleSolvers::AocDayNineSolver(std::ifstream &puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayNineSolver(std::istream& puzzleInputFile)
 {
-	std::vector<std::vector<int>> gridOfDigits = Parsing::ParseWhitespacelessGridOfDigits(puzzleInputFile);
-
-	HeightMap::HeightMap heightMap{ gridOfDigits };
+	HeightMap::HeightMap heightMap{ Parsing::ParseDigitGrid(puzzleInputFile) };
 	return PuzzleAnswerPair{
 		std::to_string(heightMap.SumLowPointRiskLevels()),
 		std::to_string(heightMap.ProductOfLargestBasins()) };
@@ -1,4 +1,5 @@
 #include "Bracket_Syntax.h"
+#include <algorithm>
 #include <cassert>
 
 // Compare a single character with the open and close characters for this bracket
@@ -16,10 +17,10 @@ Syntax::Bracket::BracketType Syntax::Bracket::DoesCharMatchAsBracket(char potent
 // add it to the total corruption detected by this syntax checker so far. Otherwise
 // work out the cost required to complete this line, again according to the puzzle
 // rules, and add it to set of completion costs for lines this checker has encountered.
-void Syntax::SyntaxChecker::ParseLine(std::string line)
+void Syntax::SyntaxChecker::ParseLine(std::string_view line)
 {
-	std::vector<char> openBracketStack{};
-	unsigned int corruptedBracketValue{ 0 };
+	openBracketStack.clear();
+	ULLINT corruptedBracketValue{ 0 };
 	ULLINT completionCost{ 0 };
 	
 	// Work along the line, doing the following for each character:
@@ -85,21 +86,26 @@ void Syntax::SyntaxChecker::ParseLine(std::string line)
 				}
 			}
 		}
-		completionCosts.insert(completionCost);
+		completionCosts.push_back(completionCost);
 	}
 }
 
+// Take in the results of all of the lines another syntax checker has parsed. Neither the
+// corruption total nor the median completion cost care which order lines came in.
+void Syntax::SyntaxChecker::Merge(SyntaxChecker&& otherChecker)
+{
+	totalCorruption += otherChecker.totalCorruption;
+	completionCosts.insert(completionCosts.end(), otherChecker.completionCosts.begin(), otherChecker.completionCosts.end());
+}
+
 // Get the median value from our list of completion costs. The puzzle input
 // guarantees there are an odd number of lines, so there will be a median
-// value.
+// value. The list doesn't need to be fully sorted to find it, just partitioned
+// around the middle.
 ULLINT Syntax::SyntaxChecker::MedianCompletionCost()
 {
 	assert(completionCosts.size() % 2 == 1);
-	unsigned int middlePosition = (completionCosts.size() / 2) + 1;
-	std::multiset<ULLINT>::iterator iter = completionCosts.begin();
-	for (unsigned int ii = 1; ii < middlePosition; ii++)
-	{
-		iter++;
-	}
-	return *iter;
+	std::vector<ULLINT>::iterator middle = completionCosts.begin() + (completionCosts.size() / 2);
+	std::nth_element(completionCosts.begin(), middle, completionCosts.end());
+	return *middle;
 }
@@ -1,7 +1,6 @@
 #pragma once
 #include <vector>
-#include <string>
-#include <set>
+#include <string_view>
 #include "aoc_common_types.h"
 
 namespace Syntax
@@ -46,16 +45,21 @@ namespace Syntax
 
 		// As lines are parsed by the syntax checker, they will either be detected as corrupted,
 		// increasing the total corruption experienced by this syntax checker, or as incomplete,
-		// in which cases the cost to autocomplete them will be added to the set of completion costs.
-		unsigned int totalCorruption{ 0 };
-		std::multiset<ULLINT> completionCosts{};
+		// in which cases the cost to autocomplete them will be added to the list of completion costs.
+		// The lines themselves are never kept, only the cost of completing each one.
+		ULLINT totalCorruption{ 0 };
+		std::vector<ULLINT> completionCosts{};
+
+		// Reused from one line to the next, so that it only allocates for the deepest line.
+		std::vector<char> openBracketStack{};
 	public:
 		SyntaxChecker(std::vector<Bracket> bracketTypes) : bracketTypes{ bracketTypes } {};
-		void ParseLine(std::string line);
+		void ParseLine(std::string_view line);
+		void Merge(SyntaxChecker&& otherChecker);
 
-		// Corruption is just a total, but completion costs are stored as an ordered set, from
+		// Corruption is just a total, but completion costs are stored as a list, from
 		// which the puzzle is interested in the median value.
-		unsigned int TotalCorruption() { return totalCorruption; }
+		ULLINT TotalCorruption() { return totalCorruption; }
 		ULLINT MedianCompletionCost();
 	};
 }
\ No newline at end of file
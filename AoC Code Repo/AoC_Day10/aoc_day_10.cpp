@@ -1,35 +1,63 @@
 #include "Bracket_Syntax.h"
-#include <iostream>
+#include <string>
 #include "puzzle_solvers.h"
-#include "Parsing.h"
+
+namespace
+{
+	// Each line is fed into the syntax checker as soon as it's read, which only keeps
+	// hold of the scores for each line rather than the lines themselves. Lines are checked
+	// independently of each other, so checkers fed different parts of the input can be
+	// merged.
+	class SyntaxCheckerSolver
+	{
+	public:
+		static constexpr std::string_view recordDelimiters{ PuzzleInput::lineEndings };
+
+		void ConsumeRecord(std::string_view record)
+		{
+			syntaxChecker.ParseLine(record);
+		}
+
+		void Merge(SyntaxCheckerSolver&& otherSolver)
+		{
+			syntaxChecker.Merge(std::move(otherSolver.syntaxChecker));
+		}
+
+		// Having seen every line, the syntax checker is able to return the two 'scores'
+		// requested by this puzzle, the first being a 'corruption' score for syntax errors,
+		// the second being the median of all of the completion costs for completing
+		// incomplete lines.
+		PuzzleAnswerPair Answers()
+		{
+			return PuzzleAnswerPair{
+				std::to_string(syntaxChecker.TotalCorruption()),
+				std::to_string(syntaxChecker.MedianCompletionCost())
+			};
+		}
+
+	private:
+		// Initialise our syntax checker with the syntax and autocomplete scores from the
+		// puzzle instructions for each bracket type.
+		Syntax::SyntaxChecker syntaxChecker{ {
+			Syntax::Bracket{'(', ')', 3, 1},
+			Syntax::Bracket{'[', ']', 57, 2},
+			Syntax::Bracket{'{', '}', 1197, 3},
+			Syntax::Bracket{'<', '>', 25137, 4}
+			} };
+	};
+}
 
 // Day 10 is a syntax checker and autocomplete tool for a series of brackets.
 // Part 1 asks us to find the first syntax error in a line (closing bracket not matching
 // the correct opening bracket).
 // Part 2 asks us to complete all of the lines which didn't contain syntax errors in part
 // 1, by adding the correct closing brackets in the right order.
-PuzzleAnswerPair PuzzleSolvers::AocDayTenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTenSolver(PuzzleInput::MappedFile const& puzzleInput)
 {
-	// Initialise our syntax checker with the syntax and autocomplete scores from the
-	// puzzle instructions for each bracket type.
-	Syntax::SyntaxChecker syntaxChecker{ {
-		Syntax::Bracket{'(', ')', 3, 1},
-		Syntax::Bracket{'[', ']', 57, 2},
-		Syntax::Bracket{'{', '}', 1197, 3},
-		Syntax::Bracket{'<', '>', 25137, 4}
-		} };
+	return SolveMappedInput<SyntaxCheckerSolver>(puzzleInput);
+}
 
-	// Feeding each of the input lines into the syntax checker leaves it able
-	// to return the two 'scores' requested by this puzzle, the first being
-	// a 'corruption' score for syntax errors, the second being the median
-	// of all of the completion costs for completing incomplete lines.
-	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
-	for (std::string inputLine : inputLines)
-	{
-		syntaxChecker.ParseLine(inputLine);
-	}
-	return PuzzleAnswerPair{
-		std::to_string(syntaxChecker.TotalCorruption()),
-		std::to_string(syntaxChecker.MedianCompletionCost())
-	};
-}
\ No newline at end of file
+PuzzleAnswerPair PuzzleSolvers::AocDayTenStreamingSolver(std::istream& puzzleInputStream)
+{
+	return SolveInputStream<SyntaxCheckerSolver>(puzzleInputStream);
+}
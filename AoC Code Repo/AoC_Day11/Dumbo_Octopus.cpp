@@ -1,76 +1,80 @@
 #include "Dumbo_Octopus.h"
 
+// Mark every octopus that has enough energy to flash but hasn't flashed yet this step
+// with a 1 in flashingInWave, and every other octopus with a 0. Returns whether any
+// octopus was marked.
+bool Dumbo::OctopusGrid::MarkOctopusesReadyToFlash()
+{
+	GridUtils::PaddedGrid<std::uint8_t> const& energyLevels = octopusEnergyLevels.Current();
+	bool anyReadyToFlash{ false };
+	for (unsigned int y = 0; y < energyLevels.Height(); y++)
+	{
+		std::uint8_t const* energyRow = energyLevels.Row(y);
+		std::uint8_t* flashingRow = flashingInWave.Row(y);
+		for (unsigned int x = 0; x < energyLevels.Width(); x++)
+		{
+			bool readyToFlash = (energyRow[x] >= levelRequiredToFlash) && (energyRow[x] < flashedThisStep);
+			flashingRow[x] = readyToFlash ? 1 : 0;
+			anyReadyToFlash = anyReadyToFlash || readyToFlash;
+		}
+	}
+	return anyReadyToFlash;
+}
+
 // Advancing a single time step causes all octopuses to increase their energy level,
 // maybe reaching the point where they flash, which further increases the energy level
 // of adjacent octopuses, maybe causing further flashes.
 void Dumbo::OctopusGrid::AdvanceSingleStep()
 {
-	// Start by simply increasing the energy levels of all octopuses and creating a vector
-	// of those which will now flash as a result.
-	std::vector<std::reference_wrapper<GridUtils::Grid<int>::GridCell>> octosToFlash;
-	for (GridUtils::Grid<int>::GridCell &octopus : octopusEnergyLevels)
+	unsigned int const width = octopusEnergyLevels.Current().Width();
+	unsigned int const height = octopusEnergyLevels.Current().Height();
+
+	// Every octopus starts by simply increasing its energy level by one.
+	for (unsigned int y = 0; y < height; y++)
 	{
-		octopus.value++;
-		if (octopus.value == levelRequiredToFlash)
-		{
-			octosToFlash.push_back(octopus);
-		}
+		std::uint8_t* energyRow = octopusEnergyLevels.Current().Row(y);
+		for (unsigned int x = 0; x < width; x++) { energyRow[x]++; }
 	}
 
-	// Now for each octopus which flashes, also increase the energy levels of adjacent
-	// octopuses. This may cause this adjacent octopus to flash, in which case we add
-	// it to the list of octopuses left to handle the flash for this step.
-	while (octosToFlash.size() > 0)
+	// Then we work through the flashes in waves. Every octopus with enough energy that
+	// hasn't yet flashed this step flashes in the next wave, and is marked as having
+	// flashed. Every other octopus gains a unit of energy for each neighbour flashing in
+	// that wave, which may bring it up to the level required to flash in the wave after.
+	// Octopuses that have already flashed can't flash again until the next step, and
+	// gaining energy makes no difference to them, so they just stay marked.
+	while (MarkOctopusesReadyToFlash())
 	{
-		GridUtils::Grid<int>::GridCell &octo = octosToFlash.back();
-		octosToFlash.pop_back();
-		octo.value = 0;
-		flashesOccuredSoFar++;
-
-		// When setting up a vector of adjacent octopuses which we should increment the
-		// energy levels for as a result of this octopus's flash, account for the possibility
-		// of this octopus being on a grid edge by just placing this octopus itself into the
-		// list for that adjacent location, and then just skip over any 'adjacent' octopuses
-		// which are in fact just this octopus (hence don't exist).
-		std::vector<std::reference_wrapper<GridUtils::Grid<int>::GridCell>> adjacentOctos{
-			octo.IsTopRow() ? octo : octo.Up(),
-			octo.IsTopRow() || octo.IsRightColumn() ? octo : octo.UpRight(),
-			octo.IsTopRow() || octo.IsLeftColumn() ? octo : octo.UpLeft(),
-			octo.IsBottomRow() ? octo : octo.Down(),
-			octo.IsBottomRow() || octo.IsRightColumn() ? octo : octo.DownRight(),
-			octo.IsBottomRow() || octo.IsLeftColumn() ? octo : octo.DownLeft(),
-			octo.IsLeftColumn() ? octo : octo.Left(),
-			octo.IsRightColumn() ? octo : octo.Right()
-		};
-		for (GridUtils::Grid<int>::GridCell& adjacentOcto : adjacentOctos)
+		GridUtils::NeighbourSums(flashingInWave, flashingNeighbours, GridUtils::Neighbourhood::EightNeighbours);
+		for (unsigned int y = 0; y < height; y++)
 		{
-			if ((octo != adjacentOcto) && AdjacentFlashTriggersOctopus(adjacentOcto))
+			std::uint8_t const* energyRow = octopusEnergyLevels.Current().Row(y);
+			std::uint8_t const* neighboursRow = flashingNeighbours.Row(y);
+			std::uint8_t* nextEnergyRow = octopusEnergyLevels.Next().Row(y);
+			for (unsigned int x = 0; x < width; x++)
 			{
-				octosToFlash.push_back(adjacentOcto);
+				nextEnergyRow[x] = (energyRow[x] >= levelRequiredToFlash) ?
+					flashedThisStep : static_cast<std::uint8_t>(energyRow[x] + neighboursRow[x]);
 			}
 		}
+		octopusEnergyLevels.Swap();
 	}
 
-	stepsTakenSoFar++;
-}
-
-// Called when an octopus adjacent to this one has flashed, causing an increase in this
-// octopus's energy level too, unless this octopus has already flashed this step, or
-// is already primed to flash (has energy of levelRequiredToFlash). Returns true if
-// this octopus is now primed to flash when it wasn't before.
-bool Dumbo::OctopusGrid::AdjacentFlashTriggersOctopus(GridUtils::Grid<int>::GridCell &octopus)
-{
-	bool octopusTriggered{ false };
-	int &octopusEnergy = octopus.value;
-	if ((octopusEnergy != 0) && (octopusEnergy != levelRequiredToFlash))
+	// Every octopus that flashed uses up all of its energy in doing so, and is ready to
+	// flash again next step.
+	for (unsigned int y = 0; y < height; y++)
 	{
-		octopusEnergy++;
-		if (octopusEnergy == levelRequiredToFlash)
+		std::uint8_t* energyRow = octopusEnergyLevels.Current().Row(y);
+		for (unsigned int x = 0; x < width; x++)
 		{
-			octopusTriggered = true;
+			if (energyRow[x] == flashedThisStep)
+			{
+				energyRow[x] = 0;
+				flashesOccuredSoFar++;
+			}
 		}
 	}
-	return octopusTriggered;
+
+	stepsTakenSoFar++;
 }
 
 // Advance time by a given number of steps. If any of these steps causes
@@ -91,7 +95,7 @@ void Dumbo::OctopusGrid::AdvanceSteps(unsigned int numSteps)
 		// is equal to the size of the grid, this was a simultaneous flash of all
 		// octopuses.
 		if ((flashesOccuredSoFar - flashesBeforeStep) ==
-			(octopusEnergyLevels.Width() * octopusEnergyLevels.Height()))
+			(octopusEnergyLevels.Current().Width() * octopusEnergyLevels.Current().Height()))
 		{
 			firstSimultaneousFlash = firstSimultaneousFlash == 0 ?
 				stepsTakenSoFar : firstSimultaneousFlash;
@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include "grid_utils.h"
+#include "Parsing.h"
 
 namespace Dumbo
 {
@@ -8,20 +10,34 @@ namespace Dumbo
 	// passes. Time passing is modelled as steps of unit time. The flashing of an
 	// octopus will increase the energy levels of adjacent octopuses further, which
 	// can cause a chain reaction of flashes.
+	// Each wave of that chain reaction is worked out for the whole grid at once: the
+	// octopuses flashing in the wave are marked in a grid of their own, the number of
+	// flashing neighbours of every octopus is summed from that, and the energy levels after
+	// the wave are worked out from those before it and the sums. The two sets of energy
+	// levels are double buffered, and the scratch grids are kept from step to step, so a
+	// wave never allocates. An octopus that has flashed is marked with an energy level far
+	// higher than any it could reach otherwise until the step is over, which is what tells
+	// the next wave it can't flash again. Nothing ever flashes in the halo.
 	class OctopusGrid
 	{
 	private:
-		static const int levelRequiredToFlash{ 10 };
+		static constexpr std::uint8_t levelRequiredToFlash{ 10 };
+		static constexpr std::uint8_t flashedThisStep{ 128 };
 		unsigned int flashesOccuredSoFar{ 0 };
 		unsigned int stepsTakenSoFar{ 0 };
 		unsigned int firstSimultaneousFlash{ 0 };
 
-		GridUtils::Grid<int> octopusEnergyLevels;
+		GridUtils::DoubleBufferedGrid<GridUtils::PaddedGrid<std::uint8_t>> octopusEnergyLevels;
+		GridUtils::PaddedGrid<std::uint8_t> flashingInWave;
+		GridUtils::PaddedGrid<std::uint8_t> flashingNeighbours;
 
+		bool MarkOctopusesReadyToFlash();
 		void AdvanceSingleStep();
-		bool AdjacentFlashTriggersOctopus(GridUtils::Grid<int>::GridCell& octopus);
 	public:
-		OctopusGrid(std::vector<std::vector<int>> startingEnergyLevels) : octopusEnergyLevels{ startingEnergyLevels } {};
+		OctopusGrid(Parsing::DigitGrid const& startingEnergyLevels) :
+			octopusEnergyLevels{ GridUtils::PaddedGrid<std::uint8_t>{ startingEnergyLevels.digits, startingEnergyLevels.width, 0 } },
+			flashingInWave{ octopusEnergyLevels.Current().Width(), octopusEnergyLevels.Current().Height(), 0 },
+			flashingNeighbours{ octopusEnergyLevels.Current().Width(), octopusEnergyLevels.Current().Height(), 0 } {};
 
 		void AdvanceSteps(unsigned int numSteps);
 		unsigned int NumberOfFlashesOccured() { return flashesOccuredSoFar; }
@@ -8,9 +8,9 @@
 // of adjacent octopuses. Part 1 asks us to find out how many flashes will have occured
 // after 100 time steps, and part 2 asks to find the number of steps before all
 // octopuses flash simulataneously for the first time.
-PuzzleAnswerPair PuzzleSolvers::AocDayElevenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayElevenSolver(std::istream& puzzleInputFile)
 {
-	Dumbo::OctopusGrid octupusEnergyGrid{ Parsing::ParseWhitespacelessGridOfDigits(puzzleInputFile) };
+	Dumbo::OctopusGrid octupusEnergyGrid{ Parsing::ParseDigitGrid(puzzleInputFile) };
 
 	octupusEnergyGrid.AdvanceSteps(100);
 	unsigned int flashesAfterHundredSteps = octupusEnergyGrid.NumberOfFlashesOccured();
@@ -9,20 +9,20 @@
 // you like, but small caves can only be visited once. Part two switches that up a bit by
 // asking us to find the number of possible routes where any given route is instead allowed
 // to visit one (and only one) of the small caves twice.
-PuzzleAnswerPair PuzzleSolvers::AocDayTwelveSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwelveSolver(std::istream& puzzleInputFile)
 {
-	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
-	std::regex matchString{ "([a-zA-Z]+)-([a-zA-Z]+)" };
+	Parsing::StringArena inputText{};
+	std::vector<std::string_view> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile, inputText);
 
 	// Piece together our cave system from the individual links between caves given
 	// to us by the puzzle input.
 	CaveRouting::CaveSystem caveSystem{};
-	std::pair<std::string, std::string> cavePair{};
-	for (std::string inputLine : inputLines)
+	std::pair<std::string_view, std::string_view> cavePair{};
+	for (std::string_view inputLine : inputLines)
 	{
-		Parsing::ParseStringIntoElements(
+		if (inputLine.empty()) { continue; }
+		Parsing::ParseValidFormattedString<"{}-{}">(
 			inputLine,
-			matchString,
 			cavePair.first,
 			cavePair.second
 		);
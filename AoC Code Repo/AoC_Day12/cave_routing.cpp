@@ -12,14 +12,14 @@ void CaveRouting::Cave::CreateCaveLink(std::weak_ptr<Cave const> caveToLink)
 // Create a Cave in the CaveSystem if that cave (identified by its name) is not
 // already known. Small caves have lower-case names, so we can do a simple char
 // to int conversion to work out whether this is a small cave.
-void CaveRouting::CaveSystem::MaybeCreateCave(std::string caveName)
+void CaveRouting::CaveSystem::MaybeCreateCave(Parsing::InternedString caveName)
 {
 	if (!cavesInSystem.contains(caveName))
 	{
-		bool isSmall = (int)caveName[0] >= 'a';
+		bool isSmall = (int)caveName.View()[0] >= 'a';
 		cavesInSystem[caveName] = std::make_shared<Cave>(caveName, isSmall);
 
-		if (caveName == StartName)
+		if (caveName == startName)
 		{
 			startCave = cavesInSystem[caveName];
 		}
@@ -28,8 +28,10 @@ void CaveRouting::CaveSystem::MaybeCreateCave(std::string caveName)
 
 // Create a 2-way link between two caves in the system, creating those caves first if either
 // is not already known by the system.
-void CaveRouting::CaveSystem::LinkCaves(std::string caveNameOne, std::string caveNameTwo)
+void CaveRouting::CaveSystem::LinkCaves(std::string_view caveNameOneText, std::string_view caveNameTwoText)
 {
+	Parsing::InternedString caveNameOne = caveNames.Intern(caveNameOneText);
+	Parsing::InternedString caveNameTwo = caveNames.Intern(caveNameTwoText);
 	MaybeCreateCave(caveNameOne);
 	MaybeCreateCave(caveNameTwo);
 	cavesInSystem[caveNameOne]->CreateCaveLink(std::weak_ptr<Cave> {cavesInSystem[caveNameTwo]});
@@ -50,7 +52,7 @@ unsigned int CaveRouting::CaveSystem::NumRoutesFromCave(std::weak_ptr<const Cave
 
 	// If this is the 'end' cave, then the route up to this point was a valid one, stop
 	// recursing and return 1.
-	if (caveShdPtr->name == EndName)
+	if (caveShdPtr->name == endName)
 	{
 		return 1;
 	}
@@ -72,7 +74,7 @@ unsigned int CaveRouting::CaveSystem::NumRoutesFromCave(std::weak_ptr<const Cave
 	{
 		if (routeSoFar.smallCavesVisited.contains(caveShdPtr->name))
 		{
-			if ((!routeSoFar.doubleVisitRemaining) || (caveShdPtr->name == StartName)) { return 0; }
+			if ((!routeSoFar.doubleVisitRemaining) || (caveShdPtr->name == startName)) { return 0; }
 			else { routeSoFar.doubleVisitRemaining = false; }
 		}
 		else
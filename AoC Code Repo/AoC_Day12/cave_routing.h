@@ -4,30 +4,33 @@
 #include <map>
 #include <cassert>
 #include <set>
+#include <string_view>
+#include "Parsing.h"
 
 namespace CaveRouting
 {
-	const std::string StartName{ "start" };
-	const std::string EndName{ "end" };
+	constexpr std::string_view StartName{ "start" };
+	constexpr std::string_view EndName{ "end" };
 
 	// A cave in the network has a name and a size, and can be linked to other caves in
-	// the network.
+	// the network. Names are interned by the cave system, so comparing two of them is just
+	// comparing two pointers.
 	class Cave
 	{
 	private:
-		std::map<std::string, std::weak_ptr<Cave const>> linkedCaves{};
+		std::map<Parsing::InternedString, std::weak_ptr<Cave const>> linkedCaves{};
 	public:
-		std::string const name;
+		Parsing::InternedString const name;
 		bool const isSmall;
 
-		Cave(std::string name, bool isSmall) : name{ name }, isSmall{ isSmall } {};
+		Cave(Parsing::InternedString name, bool isSmall) : name{ name }, isSmall{ isSmall } {};
 
 		void CreateCaveLink(std::weak_ptr<Cave const> caveToLink);
-		std::map<std::string, std::weak_ptr<Cave const>> const& LinkedCaves() const { return linkedCaves; };
+		std::map<Parsing::InternedString, std::weak_ptr<Cave const>> const& LinkedCaves() const { return linkedCaves; };
 
 		// These cave objects are inserted in a various containers which require comparison
-		// operators to be implemented. Comparison of caves can be done lexicographically with
-		// their name (which also encapsulates their size via upper/lower case-ness).
+		// operators to be implemented. Each cave has its own name, so comparing caves can be
+		// done with their names alone.
 		bool operator==(const Cave& otherCave) const { return name == otherCave.name; };
 		bool operator!=(const Cave& otherCave) const { return name != otherCave.name; };
 		bool operator<(const Cave& otherCave) const { return name < otherCave.name; };
@@ -42,7 +45,7 @@ namespace CaveRouting
 	struct RouteSoFar
 	{
 		bool doubleVisitRemaining;
-		std::set<std::string> smallCavesVisited{};
+		std::set<Parsing::InternedString> smallCavesVisited{};
 
 		RouteSoFar(bool doubleVisitAllowed) : doubleVisitRemaining{ doubleVisitAllowed } {};
 
@@ -77,7 +80,10 @@ namespace CaveRouting
 	class CaveSystem
 	{
 	private:
-		std::map<std::string, std::shared_ptr<Cave>> cavesInSystem{};
+		Parsing::StringInterner caveNames{};
+		Parsing::InternedString const startName{ caveNames.Intern(StartName) };
+		Parsing::InternedString const endName{ caveNames.Intern(EndName) };
+		std::map<Parsing::InternedString, std::shared_ptr<Cave>> cavesInSystem{};
 		std::shared_ptr<Cave> startCave{};
 
 		// For a given 'route taken so far' (which only needs to care about the small
@@ -88,9 +94,9 @@ namespace CaveRouting
 		std::map<std::pair<Cave, RouteSoFar>, unsigned int> cachedRoutesFromCaves{};
 
 		unsigned int NumRoutesFromCave(std::weak_ptr<const Cave> cave, RouteSoFar routeSoFar);
-		void MaybeCreateCave(std::string caveName);
+		void MaybeCreateCave(Parsing::InternedString caveName);
 	public:
-		void LinkCaves(std::string caveNameOne, std::string caveNameTwo);
+		void LinkCaves(std::string_view caveNameOne, std::string_view caveNameTwo);
 		unsigned int NumberOfRoutes(bool singleCaveDoubleVisitAllowed);
 	};
 }
\ No newline at end of file
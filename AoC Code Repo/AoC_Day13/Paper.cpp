@@ -1,144 +1,157 @@
 #include "Paper.h"
+#include <algorithm>
 #include <cassert>
-#include <iterator>
-#include <regex>
-#include "Parsing.h"
 
-// Make a dot on the tracing paper. This will only result in a meaningful change to the
-// viewed paper if there is a not already a dot in that position.
-// We may need to resize the grid to make room for this new dot.
-void Paper::DottedPaper::MakeDot(GridUtils::Coordinate dotCoord)
+// Make a dot on the tracing paper. The paper grows to take in the dot if it isn't already
+// big enough.
+template <typename DotsType>
+void Paper::DottedPaper<DotsType>::MakeDot(GridUtils::Coordinate dotCoord)
 {
-	MaybeResizeGrid(dotCoord);
-
-	if (!gridOfDots[dotCoord.yPos][dotCoord.xPos])
-	{
-		dotLocations.push_back(dotCoord);
-		gridOfDots[dotCoord.yPos][dotCoord.xPos] = true;
-	}
+	paperWidth = std::max(paperWidth, dotCoord.xPos + 1);
+	paperHeight = std::max(paperHeight, dotCoord.yPos + 1);
+	dots.MakeDot(dotCoord);
 }
 
 // Fold this virtual piece of tracing paper along a given line. The puzzle guarantees that
 // all folds will either be a fold to the left, or an upwards fold (i.e. the origin coordinate
 // will never move, all folds are made towards it).
-// After this fold, any dots that were in the region being folded will no longer exists
-// at their old coordinates, but will have been translated to new positions, giving us a 
-// new, smaller, pattern of dots.
-void Paper::DottedPaper::MakeFold(FoldLine foldLine)
+// After this fold, any dots that were in the region being folded will have been translated
+// to their mirror image on the other side of the fold line, giving us a new, smaller,
+// pattern of dots.
+template <typename DotsType>
+void Paper::DottedPaper<DotsType>::MakeFold(FoldLine foldLine)
 {
 	foldLine.CheckValidity();
+	dots.Fold(foldLine);
+	((foldLine.axis == 'y') ? paperHeight : paperWidth) = foldLine.position;
+}
 
-	// First shrink down the grid to remove the regions that will no longer exist under the
-	// smaller, folded piece of paper. We still have a list of the dots that existed in
-	// those regions, so we don't lose any information by doing this.
-	(foldLine.axis == 'x') ? 
-		ShrinkGridToWidth(foldLine.position) : ShrinkGridToHeight(foldLine.position);
-
-	// For each coordinate which is currently 'dotted', check to see whether that dot has
-	// been folded to a new location.
-	for (std::list<GridUtils::Coordinate>::iterator coordIter = dotLocations.begin();
-		coordIter != dotLocations.end();)
+// Prints out what a viewer of the tracing paper would currently see, using the '#' symbol
+// for dots, and whitespace for empty space. The returned string begins with a new line, to
+// ensure that the first line of the paper is correctly aligned with those below it.
+template <typename DotsType>
+std::string Paper::DottedPaper<DotsType>::FoldedPaperView() const
+{
+	std::string output{};
+	for (unsigned int row = 0; row < paperHeight; row++)
 	{
-		// The puzzle promised us that there would never be a dot actually ON the line being
-		// folded.
-		(foldLine.axis == 'x') ?
-			assert(coordIter->xPos != foldLine.position) : assert(coordIter->yPos != foldLine.position);
-
-		// If the dot was in the region we're folding, calculated the coordinate it has been
-		// folded on to. Otherwise just move our iterator on to the next dot and leave this one be.
-		GridUtils::Coordinate newDot;
-		if ((foldLine.axis == 'x') && (coordIter->xPos > foldLine.position))
-		{
-			newDot = { (coordIter->xPos - ((coordIter->xPos - foldLine.position) * 2)), coordIter->yPos };
-		}
-		else if ((foldLine.axis == 'y') && (coordIter->yPos > foldLine.position))
-		{
-			newDot = { coordIter->xPos, coordIter->yPos - ((coordIter->yPos - foldLine.position) * 2) };
-		}
-		else
+		output += '\n';
+		for (unsigned int column = 0; column < paperWidth; column++)
 		{
-			coordIter++;
-			continue;
+			if (dots.DotAt({ column, row }))
+			{
+				output += "#";
+			}
+			else
+			{
+				output += " ";
+			}
 		}
+	}
+	return output;
+}
+
+// Make a dot in the grid. We may need to resize the grid to make room for this new dot.
+void Paper::DenseDots::MakeDot(GridUtils::Coordinate dotCoord)
+{
+	MaybeResizeGrid(dotCoord);
+	gridOfDots.Set(dotCoord, 1);
+}
 
-		// If we've got this far, our old dot has been folded onto a new location. If there wasn't
-		// already a dot at that coordinate, then update our existing dot with its new coordinates
-		// and marked it as dotted on the grid. If there WAS already a dot here, then this new
-		// dot does nothing to change that status, and so can just be deleted (noting that
-		// deleting a list element returns an iterator to the next element).
-		if (!gridOfDots[newDot.yPos][newDot.xPos])
+// Fold the grid of dots along a line.
+// The grid may have been made bigger than the paper while dots were being added, but any
+// extra rows or columns are empty, so it's enough to fold those that have a mirror image
+// on the paper.
+void Paper::DenseDots::Fold(FoldLine foldLine)
+{
+	if (foldLine.axis == 'y')
+	{
+		// Folding upwards lays each row below the fold line directly on top of its mirror
+		// image, so the dots of the two rows are combined a word at a time. The puzzle
+		// promised us that there would never be a dot actually ON the line being folded.
+		unsigned int lastRowToFold = std::min((foldLine.position * 2) + 1, gridOfDots.Height());
+		for (unsigned int row = foldLine.position + 1; row < lastRowToFold; row++)
 		{
-			*coordIter = newDot;
-			gridOfDots[newDot.yPos][newDot.xPos] = true;
-			coordIter++;
+			gridOfDots.OrRow((foldLine.position * 2) - row, gridOfDots.Row(row));
 		}
-		else
+		gridOfDots.Resize(gridOfDots.Width(), foldLine.position);
+	}
+	else
+	{
+		// Folding to the left reverses the order of the columns being folded, so a copy of
+		// each row is reversed and shifted along until the column at (position + n) lies
+		// over the column at (position - n), and the two are then combined a word at a time
+		// as for an upwards fold. Whatever lands to the right of the fold line is cut off by
+		// the resize afterwards.
+		GridUtils::BitGrid mirroredRow{ gridOfDots.Width(), 1 };
+		int mirrorShift = static_cast<int>((foldLine.position * 2) + 1) - static_cast<int>(gridOfDots.Width());
+		for (unsigned int row = 0; row < gridOfDots.Height(); row++)
 		{
-			coordIter = dotLocations.erase(coordIter);
+			mirroredRow.CopyRow(0, gridOfDots.Row(row));
+			mirroredRow.ReverseRow(0);
+			mirroredRow.ShiftRow(0, mirrorShift);
+			gridOfDots.OrRow(row, mirroredRow.Row(0));
 		}
+		gridOfDots.Resize(foldLine.position, gridOfDots.Height());
 	}
 }
 
 // Given the coordinate of a new dot we are about to make on the tracing paper, resize the
 // grid if it is not currently large enough in either direction to accomodate this dot's
 // position.
-// Remember vectors being 0-indexed means the number of rows required in a given dimension
-// will be 1-greater than the maximum coordinate in that dimension.
-void Paper::DottedPaper::MaybeResizeGrid(GridUtils::Coordinate dotThatMustFit)
+// Rather than growing by just enough for each dot, which would mean copying the whole grid
+// for most dots, the grid at least doubles in size each time it has to grow. The extra space
+// is left empty, which the folds allow for.
+void Paper::DenseDots::MaybeResizeGrid(GridUtils::Coordinate dotThatMustFit)
 {
-	if (gridOfDots.size() <= dotThatMustFit.yPos)
+	unsigned int width = gridOfDots.Width();
+	unsigned int height = gridOfDots.Height();
+	if ((dotThatMustFit.xPos >= width) || (dotThatMustFit.yPos >= height))
 	{
-		gridOfDots.resize(dotThatMustFit.yPos + 1);
+		if (dotThatMustFit.xPos >= width) { width = std::max(dotThatMustFit.xPos + 1, width * 2); }
+		if (dotThatMustFit.yPos >= height) { height = std::max(dotThatMustFit.yPos + 1, height * 2); }
+		gridOfDots.Resize(width, height);
 	}
+}
 
-	int newWidth = (gridOfDots[0].size() <= (dotThatMustFit.xPos + 1)) ?
-		(dotThatMustFit.xPos + 1) : gridOfDots[0].size();
-	for (unsigned int rowNum = 0; rowNum < gridOfDots.size(); rowNum++)
+// Folding sparse dots moves every dot that's beyond the fold line across to its mirror
+// image, and every other dot straight across, into the other sparse grid. Both grids were
+// made big enough for every dot up front, so this doesn't need to allocate.
+void Paper::SparseDots::Fold(FoldLine foldLine)
+{
+	GridUtils::SparseGrid<bool>& foldedDots = dots.Next();
+	foldedDots.Clear();
+	for (GridUtils::SparseGrid<bool>::GridCell dot : dots.Current())
 	{
-		gridOfDots[rowNum].resize(newWidth);
+		GridUtils::Coordinate foldedPosition = dot.GetCoordinate();
+		unsigned int& positionAcrossFold = (foldLine.axis == 'y') ? foldedPosition.yPos : foldedPosition.xPos;
+		if (positionAcrossFold > foldLine.position) { positionAcrossFold = (foldLine.position * 2) - positionAcrossFold; }
+		foldedDots[foldedPosition].value = true;
 	}
+	dots.Swap();
 }
 
-// After a fold, resize the grid to contain only the cells required by the new width or
-// height of the grid.
-void Paper::DottedPaper::ShrinkGridToWidth(int newWidth)
+// Find how big the paper must be to hold every dot.
+Paper::PaperExtent Paper::MeasureDots(std::vector<GridUtils::Coordinate> const& dots)
 {
-	for (unsigned int rowNum = 0; rowNum < gridOfDots.size(); rowNum++)
+	PaperExtent extent{};
+	for (GridUtils::Coordinate const& dot : dots)
 	{
-		gridOfDots[rowNum].resize(newWidth);
+		extent.width = std::max(extent.width, dot.xPos + 1);
+		extent.height = std::max(extent.height, dot.yPos + 1);
 	}
-}
-void Paper::DottedPaper::ShrinkGridToHeight(int newHeight)
-{
-	gridOfDots.resize(newHeight);
+	extent.numberOfDots = dots.size();
+	return extent;
 }
 
-// Returns the number of dots currently visible on the tracing paper.
-unsigned int Paper::DottedPaper::NumberOfDots()
+// Whether the dots should be held in a grid of bits rather than as a sparse set of positions.
+// Folding a grid of bits takes time for every word of the paper, not just every dot, so for
+// dots as thinly spread as those of the real puzzle input (around 900 dots over a sheet 1300
+// by 900) the sparse positions are chosen.
+bool Paper::PaperExtent::DenseDotsAreWorthwhile() const
 {
-	return dotLocations.size();
+	return GridUtils::DenseStorageIsWorthwhile<bool>(GridUtils::BitGrid::StorageBytes(width, height), numberOfDots);
 }
 
-// Prints out what a viewer of the tracing paper would currently see, using the '#' symbol
-// for dots, and whitespace for empty space. The returned string begins with a new line, to
-// ensure that the first line of the paper is correctly aligned with those below it.
-std::string Paper::DottedPaper::FoldedPaperView()
-{
-	std::string output{};
-	for (std::vector<bool> row : gridOfDots)
-	{
-		output += '\n';
-		for (bool isDot : row)
-		{
-			if (isDot)
-			{
-				output += "#";
-			}
-			else
-			{
-				output += " ";
-			}
-		}
-	}
-	return output;
-}
+template class Paper::DottedPaper<Paper::DenseDots>;
+template class Paper::DottedPaper<Paper::SparseDots>;
\ No newline at end of file
@@ -1,12 +1,58 @@
 #pragma once
-#include <vector>
-#include <list>
 #include <string>
+#include <vector>
 #include "grid_utils.h"
 #include <cassert>
 
 namespace Paper
 {
+	// Describes a line to fold the paper along (e.g. the line x=5). It is up the the user of the
+	// struct to call CheckValidity() before attempting to use this structure to carry out a fold,
+	// to check that the line is along a valid axis, and has a real position (the entire paper
+	// exists in the positive quadrant of 2D space, so a fold along a 0-position line is not
+	// possible).
+	struct FoldLine
+	{
+		char axis;
+		unsigned int position;
+
+		void CheckValidity()
+		{
+			assert((axis == 'x') || (axis == 'y'));
+			assert(position > 0);
+		};
+	};
+
+	// The dots on a sheet of paper held as a grid of bits, one per position, so that folding
+	// rows onto each other is just OR-ing together whole words of the grid.
+	class DenseDots
+	{
+	private:
+		GridUtils::BitGrid gridOfDots;
+		void MaybeResizeGrid(GridUtils::Coordinate dotThatMustFit);
+	public:
+		DenseDots(unsigned int width, unsigned int height) : gridOfDots{ width, height } {};
+		void MakeDot(GridUtils::Coordinate dotCoord);
+		void Fold(FoldLine foldLine);
+		std::size_t NumberOfDots() const { return static_cast<std::size_t>(gridOfDots.Count()); }
+		bool DotAt(GridUtils::Coordinate position) const { return gridOfDots.Get(position) != 0; }
+	};
+
+	// The dots on a sheet of paper held as just their positions in a sparse grid, for dots
+	// spread very thinly over a large sheet. Folding moves each of them across to a second
+	// sparse grid.
+	class SparseDots
+	{
+	private:
+		GridUtils::DoubleBufferedGrid<GridUtils::SparseGrid<bool>> dots;
+	public:
+		SparseDots(std::size_t expectedDots) : dots{ GridUtils::SparseGrid<bool>{ expectedDots } } {};
+		void MakeDot(GridUtils::Coordinate dotCoord) { dots.Current()[dotCoord].value = true; }
+		void Fold(FoldLine foldLine);
+		std::size_t NumberOfDots() const { return dots.Current().NumberOfCells(); }
+		bool DotAt(GridUtils::Coordinate position) const { return dots.Current().Get(position); }
+	};
+
 	// Represents a piece of tracing paper with a number of dots made on it at positions
 	// defined by integer coordinates. This virtual piece of paper can be folder up to create
 	// an effective smaller piece of paper where dots in the folded region are now effectively
@@ -14,36 +60,35 @@ namespace Paper
 	// This class lets you make dots on a sheet of tracing paper, perform a number
 	// of folds, and then print out the resulting pattern of dots that someone viewing
 	// the tracing paper would now see.
+	// The dots can be held by anything that can make a dot, fold along a line, count its
+	// dots and say whether there's a dot at a position, so either DenseDots or SparseDots.
+	template <typename DotsType>
 	class DottedPaper
 	{
 	private:
-		std::vector<std::vector<bool>> gridOfDots{};
-		std::list<GridUtils::Coordinate> dotLocations{};
-		void MaybeResizeGrid(GridUtils::Coordinate dotThatMustFit);
-		void ShrinkGridToWidth(int newWidth);
-		void ShrinkGridToHeight(int newHeight);
+		DotsType dots;
+		unsigned int paperWidth{ 0 };
+		unsigned int paperHeight{ 0 };
 	public:
-		struct FoldLine;
+		DottedPaper(DotsType dotsIn) : dots{ std::move(dotsIn) } {};
 		void MakeDot(GridUtils::Coordinate dotCoord);
 		void MakeFold(FoldLine foldLine);
-		unsigned int NumberOfDots();
-		std::string FoldedPaperView();
+		unsigned int NumberOfDots() const { return static_cast<unsigned int>(dots.NumberOfDots()); }
+		std::string FoldedPaperView() const;
 	};
 
-	// Describes a line to fold the paper along (e.g. the line x=5). It is up the the user of the
-	// struct to call CheckValidity() before attempting to use this structure to carry out a fold,
-	// to check that the line is along a valid axis, and has a real position (the entire paper
-	// exists in the positive quadrant of 2D space, so a fold along a 0-position line is not
-	// possible).
-	struct DottedPaper::FoldLine
+	// How big a sheet of paper needs to be to hold a set of dots, and how many dots there
+	// are. From this we can tell which of the two ways of holding the dots to use.
+	struct PaperExtent
 	{
-		char axis;
-		unsigned int position;
+		unsigned int width{ 0 };
+		unsigned int height{ 0 };
+		std::size_t numberOfDots{ 0 };
 
-		void CheckValidity()
-		{
-			assert((axis == 'x') || (axis == 'y'));
-			assert(position > 0);
-		};
+		bool DenseDotsAreWorthwhile() const;
 	};
+	PaperExtent MeasureDots(std::vector<GridUtils::Coordinate> const& dots);
+
+	using DenseDottedPaper = DottedPaper<DenseDots>;
+	using SparseDottedPaper = DottedPaper<SparseDots>;
 }
\ No newline at end of file
@@ -4,15 +4,56 @@
 #include <string>
 #include "puzzle_solvers.h"
 
+namespace
+{
+	// Make the dots on the paper and then carry out the fold instructions. After the first
+	// fold, part one of the puzzle wants to know how many dots are now visible, and part two
+	// wants to see the paper once every fold has been made.
+	template <typename DotsType>
+	PuzzleAnswerPair FoldPaper(
+		std::vector<GridUtils::Coordinate> const& dots,
+		std::vector<std::string> const& instructions,
+		Paper::DottedPaper<DotsType> dottedPaper)
+	{
+		for (GridUtils::Coordinate const& dot : dots)
+		{
+			dottedPaper.MakeDot(dot);
+		}
+
+		Paper::FoldLine foldLine;
+		bool firstFoldMade = false;
+		unsigned int dotsAfterFirstFold{};
+		for (const std::string &instruction : instructions)
+		{
+			Parsing::ParseValidFormattedString<"fold along {}={}">(
+				instruction,
+				foldLine.axis,
+				foldLine.position
+			);
+			dottedPaper.MakeFold(foldLine);
+
+			if (!firstFoldMade)
+			{
+				firstFoldMade = true;
+				dotsAfterFirstFold = dottedPaper.NumberOfDots();
+			}
+		}
+
+		std::string printedWord = dottedPaper.FoldedPaperView();
+
+		return PuzzleAnswerPair{ std::to_string(dotsAfterFirstFold), printedWord };
+	}
+}
+
 // Day 13 gives us a virtual piece of tracing paper with numerous dots on it, and asks us
 // to work out what the pattern of visible dots would be after this tracing paper was folded
 // in on itself several times. The resulting paper should display a series of capital letters.
-PuzzleAnswerPair PuzzleSolvers::AocDayThirteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayThirteenSolver(std::istream& puzzleInputFile)
 {
-	Paper::DottedPaper dottedPaper{};
-
 	// Up until the first blank line, our puzzle input consists of coordinates to mark as
-	// dots on the tracing paper.
+	// dots on the tracing paper. These are all read before making the paper, so that it can
+	// be made to fit them.
+	std::vector<GridUtils::Coordinate> dots{};
 	while (true)
 	{
 		std::vector<unsigned int> coord = 
@@ -21,34 +62,19 @@ PuzzleAnswerPair PuzzleSolvers::AocDayThirteenSolver(std::ifstream& puzzleInputF
 		{
 			break;
 		}
-		dottedPaper.MakeDot({ coord[0], coord[1] });
+		dots.push_back({ coord[0], coord[1] });
 	}
 
 	// The remaining lines of input will be fold instructions for us to apply to the
-	// paper. After the first of these, part one of the puzzle wants to know how many
-	// dots are now visible.
+	// paper.
 	std::vector<std::string> instructions = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
-	Paper::DottedPaper::FoldLine foldLine;
-	bool firstFoldMade = false;
-	unsigned int dotsAfterFirstFold{};
-	for (const std::string &instruction : instructions)
+
+	// With every dot known up front, the paper can be made the right size straight away, or
+	// if the dots are spread thinly over a large sheet, made sparse instead.
+	Paper::PaperExtent paperExtent = Paper::MeasureDots(dots);
+	if (paperExtent.DenseDotsAreWorthwhile())
 	{
-		Parsing::ParseStringIntoElements(
-			instruction,
-			std::regex{ "fold along (x|y)=([0-9]+)" },
-			foldLine.axis,
-			foldLine.position
-		);
-		dottedPaper.MakeFold(foldLine);
-
-		if (!firstFoldMade)
-		{
-			firstFoldMade = true;
-			dotsAfterFirstFold = dottedPaper.NumberOfDots();
-		}
+		return FoldPaper(dots, instructions, Paper::DenseDottedPaper{ Paper::DenseDots{ paperExtent.width, paperExtent.height } });
 	}
-
-	std::string printedWord = dottedPaper.FoldedPaperView();
-
-	return PuzzleAnswerPair{ std::to_string(dotsAfterFirstFold), printedWord };
+	return FoldPaper(dots, instructions, Paper::SparseDottedPaper{ Paper::SparseDots{ paperExtent.numberOfDots } });
 }
\ No newline at end of file
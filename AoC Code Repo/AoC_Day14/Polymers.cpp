@@ -4,10 +4,10 @@
 // expressed in the form of a letter pair (e.g. "AB"), and the letter to insert in the centre of
 // each instance of that pair with each polymerisation step.
 Polymer::Polymerisation::Polymerisation(
-	std::string polymerTemplate,
-	std::vector<std::pair<std::string, char>> insertionRules)
+	std::string_view polymerTemplate,
+	std::vector<std::pair<std::string_view, char>> const& insertionRules)
 {
-	for (std::pair<std::string, char> const &rule : insertionRules)
+	for (std::pair<std::string_view, char> const &rule : insertionRules)
 	{
 		AddInsertionRule(rule);
 	}
@@ -17,21 +17,27 @@ Polymer::Polymerisation::Polymerisation(
 	// make some later work counting character occurences slightly easier).
 	for (unsigned int ii = 0; ii < polymerTemplate.size() - 1; ii++)
 	{
-		std::string elementPair = polymerTemplate.substr(ii, 2);
-		currentLetterPairTotals[elementPair]++;
+		currentLetterPairTotals[LetterPair(polymerTemplate[ii], polymerTemplate[ii + 1])]++;
 	}
 	lastCharacter = polymerTemplate[polymerTemplate.size() - 1];
 }
 
+// Look up the interned handle for a pair of letters.
+Parsing::InternedString Polymer::Polymerisation::LetterPair(char first, char second)
+{
+	char const letters[2]{ first, second };
+	return letterPairs.Intern(std::string_view{ letters, 2 });
+}
+
 // Instertion rules are initially provided as a letter to insert in the centre of each
 // instance of a given pair of letters. But for convenience of computation we want to
 // instead store this insertion rule as the two new letter pairs that will result from
 // this insertion (e.g. inserting "C" into every "AB" will result in "AC" and "CB").
-void Polymer::Polymerisation::AddInsertionRule(std::pair<std::string, char> rule)
+void Polymer::Polymerisation::AddInsertionRule(std::pair<std::string_view, char> rule)
 {
-	insertionRules[rule.first] = std::pair<std::string, std::string>{
-		std::string{rule.first[0] + std::string{rule.second}},
-		std::string{std::string{rule.second} + rule.first[1]} };
+	insertionRules[letterPairs.Intern(rule.first)] = std::pair<Parsing::InternedString, Parsing::InternedString>{
+		LetterPair(rule.first[0], rule.second),
+		LetterPair(rule.second, rule.first[1]) };
 }
 
 // Just a little helper function to reduce the level of indentation required
@@ -56,7 +62,7 @@ void Polymer::Polymerisation::MakeInsertionSteps(unsigned int numSteps)
 // rule, which is true for this puzzle and saves us some computation.
 void Polymer::Polymerisation::MakeSingleInsertionStep()
 {
-	std::unordered_map<std::string, ULLINT> newLetterPairTotals{};
+	std::unordered_map<Parsing::InternedString, ULLINT> newLetterPairTotals{};
 	for (auto const& [letterPair, currentTotal] : currentLetterPairTotals)
 	{
 		newLetterPairTotals[insertionRules[letterPair].first] += currentTotal;
@@ -80,7 +86,7 @@ ULLINT Polymer::Polymerisation::DifferenceBetweenMostAndLeastFrequentElement()
 	// pair.
 	for (auto const& [letterPair, currentTotal] : currentLetterPairTotals)
 	{
-		elementOccurences[letterPair[0]] += currentTotal;
+		elementOccurences[letterPair.View()[0]] += currentTotal;
 	}
 	elementOccurences[lastCharacter] += 1;
 
@@ -1,8 +1,10 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include "aoc_common_types.h"
+#include "Parsing.h"
 
 namespace Polymer
 {
@@ -22,18 +24,22 @@ namespace Polymer
 		// if we must insert 'C' in the centre of every 'AB', we will effectively replace every 'AB'
 		// with an 'AC' and 'CB'. That is what is represented by this mapping of initial string to
 		// a pair of new strings.
-		std::unordered_map<std::string, std::pair<std::string, std::string>> insertionRules{};
+		// There are only so many letter pairs, and every one of them is looked up over and over
+		// again, so each pair is interned once and the maps are keyed on the interned handle.
+		Parsing::StringInterner letterPairs{};
+		std::unordered_map<Parsing::InternedString, std::pair<Parsing::InternedString, Parsing::InternedString>> insertionRules{};
 
 		// Rather than keeping track of the full polymer string, we can make the program run in my lifetime
 		// by just keeing track of how many instances of each letter pair there are in the string.
 		// e.g. the string "ABAB" has 2 instances of the pair "AB", and 1 of the pair "BA".
-		std::unordered_map<std::string, ULLINT> currentLetterPairTotals;
+		std::unordered_map<Parsing::InternedString, ULLINT> currentLetterPairTotals;
 		char lastCharacter;
 
-		void AddInsertionRule(std::pair<std::string, char> rule);
+		Parsing::InternedString LetterPair(char first, char second);
+		void AddInsertionRule(std::pair<std::string_view, char> rule);
 		void MakeSingleInsertionStep();
 	public:
-		Polymerisation(std::string polymerTemplate, std::vector<std::pair<std::string, char>> insertionRules);
+		Polymerisation(std::string_view polymerTemplate, std::vector<std::pair<std::string_view, char>> const& insertionRules);
 		void MakeInsertionSteps(unsigned int numSteps);
 		ULLINT DifferenceBetweenMostAndLeastFrequentElement();
 	};
@@ -15,7 +15,7 @@
 // Step 2: ACABACACBACAB
 // This puzzle asks us to find the difference between the least and most frequently occuring
 // 'element' (i.e. letter) in the polymer (i.e. string) after 10 and 40 steps.
-PuzzleAnswerPair PuzzleSolvers::AocDayFourteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayFourteenSolver(std::istream& puzzleInputFile)
 {
 	// The first line of the input is our polymer template (the starting string e.g. "ABCAB"),
 	// followed by a blank line, and then all of the insertion rules (e.g. "AB -> C").
@@ -24,25 +24,22 @@ PuzzleAnswerPair PuzzleSolvers::AocDayFourteenSolver(std::ifstream& puzzleInputF
 	std::string emptyLine;
 	std::getline(puzzleInputFile, emptyLine);
 
-	std::vector<std::vector<std::string>> allRawInsertionRules;
-	allRawInsertionRules = Parsing::ParseMultipleLinesWithDelimiters<std::string>(puzzleInputFile, " -> ");
-
-	// Our 'raw' insertion rules were returned by the generic parsing function as a vector of
-	// vectors, so let's break them down into a more understandable vector of pairs, where each
-	// pair consists of a string of 2 letters that another must be inserted between, and then
+	// The insertion rules are parsed straight out of the lines of input, which are kept
+	// in an arena until the polymerisation has taken what it needs from them, into pairs
+	// consisting of a string of 2 letters that another must be inserted between, and then
 	// that single character that will be inserted between them.
-	std::pair<std::string, char> parsedInsertionRule;
-	std::vector<std::pair<std::string, char>> allParsedInsertionRules;
-	for (std::vector<std::string> rawInsertionRule : allRawInsertionRules)
+	Parsing::StringArena inputText{};
+	std::pair<std::string_view, char> parsedInsertionRule;
+	std::vector<std::pair<std::string_view, char>> allParsedInsertionRules;
+	for (std::string_view inputLine : Parsing::SeparateRemainingInputIntoLines(puzzleInputFile, inputText))
 	{
-		assert(
-			(rawInsertionRule.size() == 2) &&
-			(rawInsertionRule[0].size() == 2) &&
-			(rawInsertionRule[1].size() == 1)
+		if (inputLine.empty()) { break; }
+		Parsing::ParseValidFormattedString<"{} -> {}">(
+			inputLine,
+			parsedInsertionRule.first,
+			parsedInsertionRule.second
 		);
-
-		parsedInsertionRule.first = rawInsertionRule[0];
-		parsedInsertionRule.second = rawInsertionRule[1][0];
+		assert(parsedInsertionRule.first.size() == 2);
 
 		allParsedInsertionRules.push_back(parsedInsertionRule);
 	}
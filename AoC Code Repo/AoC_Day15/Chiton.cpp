@@ -2,15 +2,16 @@
 #include <cassert>
 
 // Use Djikstra's algorithm to find the cheapest path from the top left to the bottom
-// right of a grid of integers, where each integer represents the cost of moving to
+// right of a grid of digits, where each digit represents the cost of moving to
 // that point (or the 'risk' of moving to that point in the chiton cave, to use the
 // puzzle flavour).
-ULLINT Chiton::LowestRiskPath(std::vector<std::vector<int>> const &riskMap)
+ULLINT Chiton::LowestRiskPath(Parsing::DigitGrid const &riskMap)
 {
     GridUtils::Grid<RiskCell> chitonCave =
-        GridUtils::Grid<RiskCell>::GridFactory<int>(
-            riskMap,
-            [](int risk)->RiskCell { return RiskCell(risk); }
+        GridUtils::Grid<RiskCell>::GridFactory<std::uint8_t>(
+            riskMap.digits,
+            riskMap.width,
+            [](std::uint8_t risk)->RiskCell { return RiskCell(risk); }
     );
     chitonCave[{0, 0}].value.MakeStartCell();
 
@@ -74,13 +75,13 @@ void Chiton::RouteFromNextCheapestCell(
 // incoming risk. This is guaranteed to be the cheapest route we have ever found to
 // this cell, since we will only ever attempt to route to each cell once, as a
 // computational optimisation.
+// The cell is taken by value, as it's only a view onto the grid, and it's the value in
+// the grid that gets updated.
 void Chiton::UpdateCellWithCheapestRoute(
     OrderedRiskCells &orderedCells,
-    GridUtils::Grid<RiskCell>::GridCell& riskCell,
+    GridUtils::Grid<RiskCell>::GridCell riskCell,
     ULLINT incomingRisk)
 {
-    GridUtils::Grid<RiskCell>::GridCell incomingCell = riskCell;
-
     riskCell.value.IsNewLowestRisk(incomingRisk);
     orderedCells.insert(riskCell);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "grid_utils.h"
 #include "aoc_common_types.h"
+#include "Parsing.h"
 #include <vector>
 #include <set>
 
@@ -42,16 +43,16 @@ namespace Chiton
 	};
 
 	// Finds the cheapest (or 'lowest risk') path through a cave of chitons,
-	// represented as a grid of integers where each element is the risk of moving
+	// represented as a grid of digits where each element is the risk of moving
 	// through that cell. Uses Djikstra's algorithm.
-	ULLINT LowestRiskPath(std::vector<std::vector<int>> const& riskMap);
+	ULLINT LowestRiskPath(Parsing::DigitGrid const& riskMap);
 
 	void RouteFromNextCheapestCell(
 		GridUtils::Grid<RiskCell>& chitonCave,
 		OrderedRiskCells& orderedCells);
 	void UpdateCellWithCheapestRoute(
 		OrderedRiskCells &orderedCells,
-		GridUtils::Grid<RiskCell>::GridCell& riskCell,
+		GridUtils::Grid<RiskCell>::GridCell riskCell,
 		ULLINT incomingRisk);
 
 	RiskCell ReadEndCell(GridUtils::Grid<RiskCell> const &riskGrid);
@@ -3,66 +3,70 @@
 #include <iostream>
 #include "puzzle_solvers.h"
 #include "grid_utils.h"
+#include "timing.h"
 
-void EnlargeGridBy5(std::vector<std::vector<int>> &originalGrid);
+void EnlargeGridBy5(Parsing::DigitGrid &originalGrid);
 
 // Day 15 asks us to find the lowest 'risk' from the top left to bottom right of a grid
 // of integers, where each element in the grid has a risk (between 1 and 9) of moving
 // into it. For part 2, the input grid is enlarged by 5 in each direction, to force
 // us to use a sensible algorithm that solves the problem in our lifetime.
-PuzzleAnswerPair PuzzleSolvers::AocDayFifteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayFifteenSolver(std::istream& puzzleInputFile)
 {
-	std::vector<std::vector<int>> gridOfInts = Parsing::ParseWhitespacelessGridOfDigits(puzzleInputFile);
+	Parsing::DigitGrid gridOfDigits;
+	{
+		Timing::ScopedTimer timer{ "parse" };
+		gridOfDigits = Parsing::ParseDigitGrid(puzzleInputFile);
+	}
 
-	// First find the path through our initial grid of integers, then enlarge by 5
+	// First find the path through our initial grid of digits, then enlarge by 5
 	// and go again.
-	ULLINT partOneRisk = Chiton::LowestRiskPath(gridOfInts);
-	EnlargeGridBy5(gridOfInts);
-	ULLINT partTwoRisk = Chiton::LowestRiskPath(gridOfInts);
+	ULLINT partOneRisk;
+	{
+		Timing::ScopedTimer timer{ "part 1" };
+		partOneRisk = Chiton::LowestRiskPath(gridOfDigits);
+	}
+	ULLINT partTwoRisk;
+	{
+		Timing::ScopedTimer timer{ "part 2" };
+		EnlargeGridBy5(gridOfDigits);
+		partTwoRisk = Chiton::LowestRiskPath(gridOfDigits);
+	}
 
 	return PuzzleAnswerPair{ std::to_string(partOneRisk), std::to_string(partTwoRisk) };
 }
 
-// Enlarge a grid of integers by 5 in both dimensions. The enlarged grid should be formed by
+// Enlarge a grid of digits by 5 in both dimensions. The enlarged grid should be formed by
 // duplicating the original grid 4 times in each direction, but where the values in the duplicated
 // grid are increased by 1 for every step down or to the right that that copy of the grid is
 // from the original. Any value that would exceed 9 as a result is wrapped back around to 1.
-void EnlargeGridBy5(std::vector<std::vector<int>> &gridToEnlarge)
+void EnlargeGridBy5(Parsing::DigitGrid &gridToEnlarge)
 {
-	// Start off by duplicating the original grid 4 times to the right, to form a grid
-	// that is the same height as the original, but 4 times as wide. Each row is expanded
-	// in one continuous loop that takes advantage of the fact that by the time we are on
-	// to the second duplication, the elements from the first duplication will already be
-	// in place for us to copy from, with values only needing to be incremented by 1
-	// further in order for them to have been increased by 2 relative to the original grid.
-	// And so on, until we have added enough elements to produce rows that are 5 times
-	// as wide as they were.
-	for (auto &row : gridToEnlarge)
+	// Every cell of the enlarged grid comes from the cell at the same position within the
+	// original, increased by how many copies across plus how many copies down it is. Values
+	// run from 1 to 9, so wrapping round is just counting from 0 to 8 modulo 9 and adding
+	// the 1 back on at the end. The enlarged grid is written out a row at a time into a
+	// single new buffer, which then replaces the original.
+	unsigned int originalWidth = gridToEnlarge.width;
+	unsigned int originalHeight = gridToEnlarge.height;
+	std::vector<std::uint8_t> enlargedDigits(static_cast<std::size_t>(originalWidth) * originalHeight * 25);
+	std::uint8_t* nextDigit = enlargedDigits.data();
+	for (unsigned int copyDown = 0; copyDown < 5; copyDown++)
 	{
-		unsigned int originalWidth = row.size();
-		for (unsigned int ii = 0; ii < 4 * originalWidth; ii++)
+		for (unsigned int row = 0; row < originalHeight; row++)
 		{
-			int newValue = row[ii];
-			if (newValue == 9) { newValue = 1; }
-			else { newValue += 1; }				
-			row.push_back(newValue);
+			std::uint8_t const* originalRow = gridToEnlarge.digits.data() + (static_cast<std::size_t>(row) * originalWidth);
+			for (unsigned int copyAcross = 0; copyAcross < 5; copyAcross++)
+			{
+				for (unsigned int column = 0; column < originalWidth; column++)
+				{
+					*nextDigit++ = static_cast<std::uint8_t>(((originalRow[column] - 1 + copyDown + copyAcross) % 9) + 1);
+				}
+			}
 		}
 	}
 
-	// Now work our way down to create a grid that is 5 times as high as the original. We will
-	// use the same trick we did when widening the rows to allow ourselves to do this in a single
-	// loop, where the value each element added only needs to be increased by 1 more than the
-	// value in the row it is being copied from.
-	unsigned int originalHeight = gridToEnlarge.size();
-	for (unsigned int ii = 0; ii < 4 * originalHeight; ii++)
-	{
-		std::vector<int> row = gridToEnlarge[ii];
-		for (int &element : row)
-		{
-			if (element == 9) { element = 1; }
-			else { element += 1; }
-		}
-
-		gridToEnlarge.push_back(row);
-	}
+	gridToEnlarge.digits = std::move(enlargedDigits);
+	gridToEnlarge.width = originalWidth * 5;
+	gridToEnlarge.height = originalHeight * 5;
 }
\ No newline at end of file
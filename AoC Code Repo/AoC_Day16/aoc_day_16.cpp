@@ -13,17 +13,17 @@
 // contained within the outer packet, taking the versions of all of the nested packets
 // into account. Part 2 asks to evaluate the value of the outer operator packet, using
 // various rules for calculating the value of the different packet 'types'.
-PuzzleAnswerPair PuzzleSolvers::AocDaySixteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDaySixteenSolver(std::istream& puzzleInputFile)
 {
 	// Input is given as a hex string, but the packet is defined in terms of irregular
-	// chunks of binary rather than nice bytes, so the first task is to parse the hex out
-	// into binary.
+	// chunks of binary rather than nice bytes, so the first task is to pack the hex into
+	// bits we can read those chunks out of.
 	std::string hexString = Parsing::ReadSingleStringFromInputFile(puzzleInputFile);
-	std::string binaryString = Parsing::ConvertHexStringToBinary(hexString);
+	Parsing::HexBitReader packetBits{ hexString };
 
 	// Then we can parse this out into the complete packet, and retrieve the sum of versions
 	// and the packet's value.
-	Packet::OperatorPacket outerPacket = Packet::OperatorPacket::CreateOperatorPacket(binaryString);
+	Packet::OperatorPacket outerPacket = Packet::OperatorPacket::CreateOperatorPacket(packetBits);
 	unsigned int sumOfVersion = outerPacket.SumOfVersions();
 	ULLINT packetValue = outerPacket.Value();
 
@@ -3,23 +3,20 @@
 #include <cassert>
 #include <iostream>
 
-// Given the string representing an entire operator packet (not having parsed out the version
+// Given the bits making up an entire operator packet (not having parsed out the version
 // and typeID), return that OperatorPacket.
-Packet::OperatorPacket Packet::OperatorPacket::CreateOperatorPacket(std::string &completePacket)
+Packet::OperatorPacket Packet::OperatorPacket::CreateOperatorPacket(Parsing::HexBitReader& completePacket)
 {
-	int versionIn = static_cast<int>(Parsing::ConvertBinaryToInt(completePacket.substr(0, 3)));
-	completePacket.erase(0, 3);
-
-	int typeIDIn = static_cast<int>(Parsing::ConvertBinaryToInt(completePacket.substr(0, 3)));
-	completePacket.erase(0, 3);
+	int versionIn = static_cast<int>(completePacket.ReadBits(3));
+	int typeIDIn = static_cast<int>(completePacket.ReadBits(3));
 	assert(typeIDIn != literalID);
 
 	return OperatorPacket(versionIn, typeIDIn, completePacket);
 }
 
-// Construct an OperatorPacket object given a version, typeID, and the packet contents as
-// a string of binary.
-Packet::OperatorPacket::OperatorPacket(int versionIn, int typeIDIn, std::string& contents)
+// Construct an OperatorPacket object given a version, typeID, and a reader positioned at
+// the start of the packet contents.
+Packet::OperatorPacket::OperatorPacket(int versionIn, int typeIDIn, Parsing::HexBitReader& contents)
 {
 	version = versionIn;
 	typeID = typeIDIn;
@@ -31,18 +28,15 @@ Packet::OperatorPacket::OperatorPacket(int versionIn, int typeIDIn, std::string&
 	// is 11 bits long, otherwise the length type ID is 0, and the length descriptor is
 	// 15 bits long. The length descriptor is just stored raw here, it will be parsed
 	// properly as part of parsing the packet contents.
-	lengthTypeID = static_cast<int>(Parsing::ConvertBinaryToInt(contents.substr(0, 1)));
-	contents.erase(0, 1);
+	lengthTypeID = static_cast<int>(contents.ReadBits(1));
 	if (lengthTypeID == 1)
 	{
-		lengthDescriptor = static_cast<unsigned int>(Parsing::ConvertBinaryToInt(contents.substr(0, 11)));
-		contents.erase(0, 11);
+		lengthDescriptor = static_cast<unsigned int>(contents.ReadBits(11));
 	}
 	else
 	{
 		assert(lengthTypeID == 0);
-		lengthDescriptor = static_cast<unsigned int>(Parsing::ConvertBinaryToInt(contents.substr(0, 15)));
-		contents.erase(0, 15);
+		lengthDescriptor = static_cast<unsigned int>(contents.ReadBits(15));
 	}
 
 	ParseContents(contents);
@@ -50,20 +44,20 @@ Packet::OperatorPacket::OperatorPacket(int versionIn, int typeIDIn, std::string&
 
 // Parse out the contents of this OperatorPacket into the respective child packets.
 // We use the length descriptor to work out how long this OperatorPacket is and
-// only parse out as much of the contents string as is required to form that contents.
-void Packet::OperatorPacket::ParseContents(std::string& contents)
+// only read as many bits as are required to form that contents.
+void Packet::OperatorPacket::ParseContents(Parsing::HexBitReader& contents)
 {
 	// If the length type ID is 0, the length descriptor represents the length of this
-	// packet's contents in bits. So keep parsing child packets off the front of the contents
-	// string until we've read the right number of bits.
+	// packet's contents in bits. So keep parsing child packets until the reader has
+	// moved on by the right number of bits.
 	if (lengthTypeID == 0)
 	{
-		ULLINT initialSize = contents.size();
-		while (contents.size() > (initialSize - lengthDescriptor))
+		std::size_t contentsEnd = contents.Position() + lengthDescriptor;
+		while (contents.Position() < contentsEnd)
 		{
 			ParseNextChildPacket(contents);
 		}
-		assert(contents.size() == initialSize - lengthDescriptor);
+		assert(contents.Position() == contentsEnd);
 	}
 	// Otherwise the type ID is 0, and the length descriptor represents the number of
 	// child packets within this operator pacekt, so just parse out that many child
@@ -77,20 +71,16 @@ void Packet::OperatorPacket::ParseContents(std::string& contents)
 	}
 }
 
-// Parse out the next child packet of this Operator packet from the contents string.
-// This will remove the portion of the contents string representing this child packet
-// (including any of its own children), so it is ready to have the next packet parsed
-// from it.
-// We first strip out the 3 bits each for the version and typeID of this child packet.
+// Parse out the next child packet of this Operator packet from the contents. This will
+// move the reader on past this child packet (including any of its own children), so it
+// is ready to have the next packet parsed from it.
+// We first read the 3 bits each for the version and typeID of this child packet.
 // Depending on the typeID, that child may be either a Literal or OperatorPacket, and
 // we should create it as such.
-void Packet::OperatorPacket::ParseNextChildPacket(std::string & packets)
+void Packet::OperatorPacket::ParseNextChildPacket(Parsing::HexBitReader& packets)
 {
-	int childVersion = (int)Parsing::ConvertBinaryToInt(packets.substr(0, 3));
-	packets.erase(0, 3);
-
-	int childTypeID = (int)Parsing::ConvertBinaryToInt(packets.substr(0, 3));
-	packets.erase(0, 3);
+	int childVersion = static_cast<int>(packets.ReadBits(3));
+	int childTypeID = static_cast<int>(packets.ReadBits(3));
 
 	if (childTypeID == literalID)
 	{
@@ -156,14 +146,12 @@ int Packet::OperatorPacket::SumOfVersions() const
 }
 
 // 'Literal' packets contain no inner packets, their value can be deduced through a
-// simple parsing of the binary string making up their contents.
+// simple parsing of the bits making up their contents.
 // This constructor produces such a LiteralPacket, parsing that value from the
-// provided 'contents' string. It is possible that this contents string has further
-// packets after the literal contents, but this constructor only reads as much as
-// is required to get the literal value. The binary making up the literal will be stripped
-// from the contents as it is parsed, so that contents is left ready to have further
-// packets parsed from it.
-Packet::LiteralPacket::LiteralPacket(int versionIn, int typeIDIn, std::string & contents)
+// provided 'contents' reader. It is possible that there are further packets after the
+// literal contents, but this constructor only reads as much as is required to get the
+// literal value, leaving the reader ready to have further packets parsed from it.
+Packet::LiteralPacket::LiteralPacket(int versionIn, int typeIDIn, Parsing::HexBitReader& contents)
 {
 	version = versionIn;
 	typeID = typeIDIn;
@@ -171,21 +159,15 @@ Packet::LiteralPacket::LiteralPacket(int versionIn, int typeIDIn, std::string &
 	// Parse contents as per puzzle rules. The binary number representing the value
 	// is broken up into 4 bit chunks. Each of these chunks is prefixed with a '1',
 	// except for the final one, which is prefixed with '0'. We use this knowledge
-	// to extract the binary number from the front of the contents string until we
-	// reach the final chunk, indicated by its 0 prefix. Contents is stripped as
-	// we go.
-	std::string valueAsBinary;
+	// to build up the value a chunk at a time until we reach the final chunk,
+	// indicated by its 0 prefix.
+	value = 0;
 	bool reachedEnd{ false };
 	while (!reachedEnd)
 	{
-		if (Parsing::ConvertBinaryToInt(contents.substr(0, 1)) == 0) { reachedEnd = true; }
-		contents.erase(0, 1);
-
-		valueAsBinary += contents.substr(0, 4);
-		contents.erase(0, 4);
+		reachedEnd = !contents.ReadBit();
+		value = (value << 4) | contents.ReadBits(4);
 	}
-
-	value = Parsing::ConvertBinaryToInt(valueAsBinary);
 }
 
 // Return the sum of the values of this packet's contents.
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include "aoc_common_types.h"
+#include "Parsing.h"
 #include <memory>
 
 namespace Packet
@@ -33,7 +34,7 @@ namespace Packet
 	private:
 		ULLINT value;
 	public:
-		LiteralPacket(int versionIn, int typeIDIn, std::string &contents);
+		LiteralPacket(int versionIn, int typeIDIn, Parsing::HexBitReader& contents);
 		~LiteralPacket() override = default;
 
 		int SumOfVersions() const override { return version; }
@@ -50,8 +51,8 @@ namespace Packet
 		unsigned int lengthDescriptor;
 		std::vector<std::unique_ptr<Packet>> contents{};
 
-		void ParseNextChildPacket(std::string &packets);
-		void ParseContents(std::string &contents);
+		void ParseNextChildPacket(Parsing::HexBitReader& packets);
+		void ParseContents(Parsing::HexBitReader& contents);
 
 		ULLINT SumOperation() const;
 		ULLINT ProductOperation() const;
@@ -70,8 +71,8 @@ namespace Packet
 		static const int lessThanID{ 6 };
 		static const int equalToOperation{ 7 };
 	public:
-		static OperatorPacket CreateOperatorPacket(std::string& completePacket);
-		OperatorPacket(int versionIn, int typeIDIn, std::string& contents);
+		static OperatorPacket CreateOperatorPacket(Parsing::HexBitReader& completePacket);
+		OperatorPacket(int versionIn, int typeIDIn, Parsing::HexBitReader& contents);
 		~OperatorPacket() override = default;
 
 		ULLINT Value() const override;
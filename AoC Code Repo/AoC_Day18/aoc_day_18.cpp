@@ -13,7 +13,7 @@
 // We are also asked to find the magnitude of snailfish numbers, which is done by adding 3 times
 // the magnitude of left element to 2 times the magnitude of the right element (if either of those
 // elements are themselves snailfish numbers, their individual magnitudes must be calculated first).
-PuzzleAnswerPair PuzzleSolvers::AocDayEighteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayEighteenSolver(std::istream& puzzleInputFile)
 {
 	std::vector<std::string> snailNumbersAsString = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
 
@@ -4,6 +4,7 @@
 #include "puzzle_solvers.h"
 #include "Beacon.h"
 #include <vector>
+#include "timing.h"
 
 // For day 19, we have a number of scanners and beacons floating in the ocean. Each scanner
 // can detect the beacons within 1000 metres of themselves in each direction, but do not know
@@ -16,25 +17,28 @@
 // exist within.
 // For part one we must then report the total number of *beacons* in existence.
 // For part two we must find the greatest 'Manhattan distance' between any two *scanners*.
-PuzzleAnswerPair PuzzleSolvers::AocDayNineteenSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayNineteenSolver(std::istream& puzzleInputFile)
 {
 	// The input is given as a scanner number, followed by a number of lines giving the
 	// coordinates of beacons that scanner can detect, in the form "x,y,z". There is a
 	// blank line separating each scanner's portion of the input.
 	// From this we put together our list of scanners.
 	std::vector<std::shared_ptr<Beacons::Scanner>> scanners;
-	std::regex scannerHeaderRegex{ "--- scanner [0-9]+ ---" };
-	unsigned int scannerIndex{ 0 };
-	while (!puzzleInputFile.eof())
 	{
-		std::string scannerHeader{};
-		std::getline(puzzleInputFile, scannerHeader);
-		assert(std::regex_match(scannerHeader, scannerHeaderRegex));
+		Timing::ScopedTimer timer{ "parse" };
+		std::regex scannerHeaderRegex{ "--- scanner [0-9]+ ---" };
+		unsigned int scannerIndex{ 0 };
+		while (!puzzleInputFile.eof())
+		{
+			std::string scannerHeader{};
+			std::getline(puzzleInputFile, scannerHeader);
+			assert(std::regex_match(scannerHeader, scannerHeaderRegex));
 
-		std::vector<std::vector<int>> beaconPositions = Parsing::ParseMultipleLinesWithDelimiters<int>(
-			puzzleInputFile, Parsing::comma);
-		scanners.push_back(std::make_shared<Beacons::Scanner>(scannerIndex, beaconPositions));
-		scannerIndex++;
+			std::vector<std::vector<int>> beaconPositions = Parsing::ParseMultipleLinesWithDelimiters<int>(
+				puzzleInputFile, Parsing::comma);
+			scanners.push_back(std::make_shared<Beacons::Scanner>(scannerIndex, beaconPositions));
+			scannerIndex++;
+		}
 	}
 
 	// We want to find the overlapping scanners without wasting work, but without missing
@@ -54,21 +58,24 @@ PuzzleAnswerPair PuzzleSolvers::AocDayNineteenSolver(std::ifstream& puzzleInputF
 	std::list<unsigned int> nextScannersToRouteFrom;
 	nextScannersToRouteFrom.push_back(0);	
 
-	unsigned int numScannersRoutedTo = 1;
-	while (numScannersRoutedTo < scanners.size())
 	{
-		unsigned int scannerToRouteFrom = nextScannersToRouteFrom.front();
-		nextScannersToRouteFrom.pop_front();
-
-		for (unsigned int otherScanner = 0; otherScanner < scanners.size(); otherScanner++)
+		Timing::ScopedTimer timer{ "find overlaps" };
+		unsigned int numScannersRoutedTo = 1;
+		while (numScannersRoutedTo < scanners.size())
 		{
-			if (scannersRoutedTo[otherScanner]) { continue; }
+			unsigned int scannerToRouteFrom = nextScannersToRouteFrom.front();
+			nextScannersToRouteFrom.pop_front();
 
-			if (scanners[scannerToRouteFrom]->CheckForOverlap(scanners[otherScanner]))
+			for (unsigned int otherScanner = 0; otherScanner < scanners.size(); otherScanner++)
 			{
-				scannersRoutedTo[otherScanner] = true;
-				numScannersRoutedTo++;
-				nextScannersToRouteFrom.push_back(otherScanner);
+				if (scannersRoutedTo[otherScanner]) { continue; }
+
+				if (scanners[scannerToRouteFrom]->CheckForOverlap(scanners[otherScanner]))
+				{
+					scannersRoutedTo[otherScanner] = true;
+					numScannersRoutedTo++;
+					nextScannersToRouteFrom.push_back(otherScanner);
+				}
 			}
 		}
 	}
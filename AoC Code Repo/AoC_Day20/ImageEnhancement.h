@@ -1,8 +1,10 @@
 #pragma once
+#include <bitset>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <deque>
 #include <cassert>
+#include "grid_utils.h"
 
 namespace Image
 {
@@ -13,40 +15,46 @@ namespace Image
 	// The enhancement algorithm is a wrapper around a string like "#.##.#.", although the real string
 	// must be 512 characters long, so that there is a character within it for every possible 9 digit
 	// binary number.
-	// The enhancement algorithm must be able to tell us what the new value of a given cell in the grid
-	// should be after a single enhancement step.
+	// The enhancement algorithm must be able to tell us whether a given cell in the grid
+	// will be light after a single enhancement step, given the 9 digit binary number formed
+	// from that cell and its neighbours.
 	class EnhancementAlgorithm
 	{
 	private:
-		std::string algorithmString{};
+		std::bitset<NumberOfNineDigitBinaryNumbers> lightCells{};
 	public:
 		EnhancementAlgorithm() {};
-		EnhancementAlgorithm(std::string algorithmString) : algorithmString { algorithmString } 
+		EnhancementAlgorithm(std::string const& algorithmString)
 		{
 			assert(algorithmString.size() == NumberOfNineDigitBinaryNumbers);
+			for (unsigned int pos = 0; pos < NumberOfNineDigitBinaryNumbers; pos++)
+			{
+				lightCells[pos] = (algorithmString[pos] == LightCell);
+			}
 		};
 
-		char NextValueOfCell(
-			unsigned int row,
-			unsigned int column,
-			std::deque<std::string> const& image);
-		char CellAtPosition(unsigned int pos) { return algorithmString[pos]; }
+		bool CellAtPositionIsLight(unsigned int pos) const { return lightCells[pos]; }
 	};
 
 	// An Image is formed from an initial unenhanced image, and the enhancement algorithm
 	// to apply for each enhancement step.
 	// The Image must be able to undergo enhancement steps when instructed, and also
 	// report the number of cells which are currently light at any point.
+	// The image is held as a grid of bytes, 1 for a light cell, with a halo around it holding
+	// the value of the infinite region beyond. The image before and after each round are
+	// double buffered, and grow into their halos as the image spreads outwards.
+	// A byte per cell takes eight times the memory a BitGrid would, but lets the image be
+	// enhanced with the same stencils as the other grids, and even after 50 rounds the
+	// image is only a couple of hundred cells across.
 	class Image
 	{
 	private:
-		std::deque<std::string> image;
+		GridUtils::DoubleBufferedGrid<GridUtils::PaddedGrid<std::uint8_t>> image;
 		EnhancementAlgorithm enhancementAlgorithm;
 		bool outsideIsLight{ false };
 		void UndergoSingleRoundOfEnhancement();
-		void ApplyInfinityBuffers();
 	public:
-		Image(std::deque<std::string> unenhancedImage, EnhancementAlgorithm algorithm);
+		Image(std::vector<std::string> const& unenhancedImage, EnhancementAlgorithm algorithm);
 
 		void UndergoRoundsOfEnhancement(unsigned int numberOfRounds);
 		int NumberOfLightCells();
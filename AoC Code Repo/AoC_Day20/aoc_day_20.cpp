@@ -12,7 +12,7 @@
 // cell.
 // Part one asks us to find how many cells are 'light' (meaning '#') after 2 steps of the enhancement
 // process. Part two asks for the same, but after a further 48 steps (for 50 total steps).
-PuzzleAnswerPair PuzzleSolvers::AocDayTwentySolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwentySolver(std::istream& puzzleInputFile)
 {
 	// The first like of the input is our enhancement algorithm.
 	std::string enhancementAlgorithmAsString{};
@@ -26,12 +26,7 @@ PuzzleAnswerPair PuzzleSolvers::AocDayTwentySolver(std::ifstream& puzzleInputFil
 
 	// The remaining lines make up our initial image, which is a grid of '#' and '.'
 	// characters.
-	std::deque<std::string> blurryImage{};
-	std::vector<std::string> imageLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
-	for (std::string const &imageLine : imageLines)
-	{
-		blurryImage.push_back(imageLine);
-	}
+	std::vector<std::string> blurryImage = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
 
 	Image::Image imageBeingEnhanced{ blurryImage, enhancementAlgorithm };
 
@@ -14,7 +14,7 @@
 // For part 2, we play with a quantum dice which splits the universe into a number of possible
 // realities each time it is rolled. We are required to find out which player wins in more universes,
 // and return the number of universes in which that player wins. 
-PuzzleAnswerPair PuzzleSolvers::AocDayTwentyOneSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwentyOneSolver(std::istream& puzzleInputFile)
 {
 	// Parse out the starting position of each player from our puzzle input.
 	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
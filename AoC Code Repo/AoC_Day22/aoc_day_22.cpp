@@ -1,10 +1,10 @@
 #include "Reactor.h"
 #include "Parsing.h"
 #include <iostream>
-#include <regex>
 #include <cassert>
 #include <deque>
 #include "puzzle_solvers.h"
+#include "timing.h"
 
 // Day 22 asks us to "initialize a reactor". The link between the theme and the actual problem is
 // pretty tenuous with this one, what it really asks us to do is apply a series of instructions to
@@ -16,48 +16,58 @@
 // For part 1 we only consider those instructions which refer to regions within a 100x100x100
 // cube centred on (0,0,0). This is the 'initialisation zone' of the reactor.
 // For part 2 we consider all of the instructions.
-PuzzleAnswerPair PuzzleSolvers::AocDayTwentyTwoSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwentyTwoSolver(std::istream& puzzleInputFile)
 {
-	// Use a regex to parse each instruction into whether it is an 'on' or 'off'
+	// Parse each instruction into whether it is an 'on' or 'off'
 	// instruction, and the 3 ranges (x,y,z) that describe the space the instruction acts on.
-	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
+	// Each line is parsed on its own, so a large input is split up and parsed in parallel.
 	std::vector<std::pair<bool, Reactor::InstructionVolume>> instructions;
-	for (std::string &instruction : inputLines)
 	{
-		std::regex instructionPattern{
-			"^([a-z]+) x=(-{0,1}[0-9]+)..(-{0,1}[0-9]+),y=(-{0,1}[0-9]+)..(-{0,1}[0-9]+),z=(-{0,1}[0-9]+)..(-{0,1}[0-9]+)$"
-		};
-		std::string onOrOff;
-		std::pair<int, int> xRange;
-		std::pair<int, int> yRange;
-		std::pair<int, int> zRange;
-		Parsing::ParseStringIntoElements(
-			instruction,
-			instructionPattern,
-			onOrOff,
-			xRange.first,
-			xRange.second,
-			yRange.first,
-			yRange.second,
-			zRange.first,
-			zRange.second);
+		Timing::ScopedTimer timer{ "parse" };
+		std::string inputStorage{};
+		std::string_view inputText = PuzzleInput::RemainingText(puzzleInputFile, inputStorage);
+		instructions = PuzzleInput::ParseLinesInParallel<std::pair<bool, Reactor::InstructionVolume>>(
+			inputText,
+			[](std::string_view instruction)
+			{
+				std::string_view onOrOff;
+				std::pair<int, int> xRange;
+				std::pair<int, int> yRange;
+				std::pair<int, int> zRange;
+				Parsing::ParseValidFormattedString<"{} x={}..{},y={}..{},z={}..{}">(
+					instruction,
+					onOrOff,
+					xRange.first,
+					xRange.second,
+					yRange.first,
+					yRange.second,
+					zRange.first,
+					zRange.second);
 
-		assert((onOrOff == "on") || (onOrOff == "off"));
-		bool settingIsOn = (onOrOff == "on");
+				assert((onOrOff == "on") || (onOrOff == "off"));
+				bool settingIsOn = (onOrOff == "on");
 
-		instructions.push_back({ settingIsOn, { xRange, yRange, zRange } });
+				return std::pair<bool, Reactor::InstructionVolume>{ settingIsOn, { xRange, yRange, zRange } };
+			});
 	}
 
 	// Our part one reactor should only consider instructions that fall in the 100-unit cube
 	// centred on (0,0,0). This is the range -50 to 50 on each axis.
 	// Part 2 covers the complete reactor and uses all instructions.
-	Reactor::Reactor initializationZone{ instructions, { -50, 50 }, { -50, 50 }, { -50, 50 } };
-	Reactor::Reactor completeReactor{ instructions };
-
 	// For the initialization zone in part one, and for the complete reactor in part two,
 	// we are required to find the number of coordinates in the reactor which are now 'on'.
-	return PuzzleAnswerPair{
-		std::to_string(initializationZone.NumberOfOnCubes()),
-		std::to_string(completeReactor.NumberOfOnCubes())
-	};
+	ULLINT partOneOnCubes;
+	{
+		Timing::ScopedTimer timer{ "part 1" };
+		Reactor::Reactor initializationZone{ instructions, { -50, 50 }, { -50, 50 }, { -50, 50 } };
+		partOneOnCubes = initializationZone.NumberOfOnCubes();
+	}
+	ULLINT partTwoOnCubes;
+	{
+		Timing::ScopedTimer timer{ "part 2" };
+		Reactor::Reactor completeReactor{ instructions };
+		partTwoOnCubes = completeReactor.NumberOfOnCubes();
+	}
+
+	return PuzzleAnswerPair{ std::to_string(partOneOnCubes), std::to_string(partTwoOnCubes) };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "amphipod_burrows.h"
 #include "Parsing.h"
 #include <regex>
+#include "timing.h"
 
 // Day 23 asks us to find the most efficient way to reorganise some amphipods within their burrows.
 // Our puzzle input shows the initial state of the warren, with Amber (A), Bronze (B), Copper (C)
@@ -38,7 +39,7 @@
 //   #D#B#A#C#
 //   #D#C#B#A#
 //   #########
-PuzzleAnswerPair PuzzleSolvers::AocDayTwentyThreeSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwentyThreeSolver(std::istream& puzzleInputFile)
 {
 	// Parse out the couple of lines of input which are actually interesting, checking that the
 	// surrounding lines match what we'd expect for this puzzle's input too, just for good measure.
@@ -119,8 +120,16 @@ PuzzleAnswerPair PuzzleSolvers::AocDayTwentyThreeSolver(std::ifstream& puzzleInp
 	// cheapest solves.
 	Amphipod::WarrenSolver warrenSolver{ 2, amberBurrow, bronzeBurrow, copperBurrow, desertBurrow };
 	Amphipod::WarrenSolver deeperWarrenSolver{ 4, deeperAmberBurrow, deeperBronzeBurrow, deeperCopperBurrow, deeperDesertBurrow };
-	unsigned int cheapestSolvePartOne = warrenSolver.CheapestSolve();
-	unsigned int cheapestSolvePartTwo = deeperWarrenSolver.CheapestSolve();
+	unsigned int cheapestSolvePartOne;
+	{
+		Timing::ScopedTimer timer{ "part 1" };
+		cheapestSolvePartOne = warrenSolver.CheapestSolve();
+	}
+	unsigned int cheapestSolvePartTwo;
+	{
+		Timing::ScopedTimer timer{ "part 2" };
+		cheapestSolvePartTwo = deeperWarrenSolver.CheapestSolve();
+	}
 
 	return PuzzleAnswerPair{ std::to_string(cheapestSolvePartOne), std::to_string(cheapestSolvePartTwo)};
 }
\ No newline at end of file
@@ -7,19 +7,20 @@
 #include <optional>
 #include <map>
 #include "aoc_common_types.h"
+#include "Parsing.h"
 
 namespace ALU
 {
 	// The set of instructions to be performed by each 'stage' of the ALU (where a stage
 	// is the execution carried out between requests for input) is identical for every
-	// stage, apart from a few particular values. This regex represents those identical
-	// instructions with capture groups for the variable values.
-	const std::string regexMatchString{
-		"^mul x 0\n"
+	// stage, apart from a few particular values. This format represents those identical
+	// instructions with placeholders for the variable values.
+	constexpr Parsing::FormatString stageFormat{
+		"mul x 0\n"
 		"add x z\n"
 		"mod x 26\n"
-		"div z ([-]{0,1}[0-9]+)\n"
-		"add x ([-]{0,1}[0-9]+)\n"
+		"div z {}\n"
+		"add x {}\n"
 		"eql x w\n"
 		"eql x 0\n"
 		"mul y 0\n"
@@ -29,9 +30,9 @@ namespace ALU
 		"mul z y\n"
 		"mul y 0\n"
 		"add y w\n"
-		"add y ([-]{0,1}[0-9]+)\n"
+		"add y {}\n"
 		"mul y x\n"
-		"add z y\n$"
+		"add z y\n"
 	};
 
 	// Represents a valid set of inputs to insert into the w register for the remaining
@@ -1,7 +1,7 @@
 #include "puzzle_solvers.h"
 #include "Parsing.h"
+#include <cassert>
 #include "alu.h"
-#include <regex>
 
 // For day 24 we must model the submarine's Arithmetic Logic Unit (ALU). Our puzzle input
 // is a series of operations which will be performed by this ALU to manipulate its 4 registers,
@@ -11,13 +11,14 @@
 // smallest 14 digit numbers that could be used as input to leave the z register with a final value
 // of 0. Solving this in a timely fashion requires us to do some manual inspection of this input
 // which is covered in more details in comments closer to the relevant code.
-PuzzleAnswerPair PuzzleSolvers::AocDayTwentyFourSolver(std::ifstream& puzzleInputFile)
+PuzzleAnswerPair PuzzleSolvers::AocDayTwentyFourSolver(std::istream& puzzleInputFile)
 {
 	// The operations performed by this ALU can be broken up into 14 stages, where each stage is the
 	// set of operations performed between each request for input (which is displayed as 'inp w' in
 	// the list of operations, instructing the ALU to read user input and store it in the w register).
 	std::vector<ALU::ALUStage> aluStages;
-	assert(Parsing::ReadWholeLineFromInputFile(puzzleInputFile) == "inp w");
+	[[maybe_unused]] std::string firstLine = Parsing::ReadWholeLineFromInputFile(puzzleInputFile);
+	assert(firstLine == "inp w");
 	std::vector<std::string> inputLines = Parsing::SeparateRemainingInputIntoLines(puzzleInputFile);
 	
 	// It turns out that each 'stage' of operations is almost identical, with the only differences
@@ -28,13 +29,12 @@ PuzzleAnswerPair PuzzleSolvers::AocDayTwentyFourSolver(std::ifstream& puzzleInpu
 	int zDivValue;
 	int xAddValue;
 	int yAddValue;
-	std::regex matchString{ ALU::regexMatchString };
 	std::string singleStageAsString{};
 	for (std::string inputLine : inputLines)
 	{
 		if (inputLine == "inp w")
 		{
-			Parsing::ParseStringIntoElements(singleStageAsString, matchString, zDivValue, xAddValue, yAddValue);
+			Parsing::ParseValidFormattedString<ALU::stageFormat>(singleStageAsString, zDivValue, xAddValue, yAddValue);
 			aluStages.emplace_back(zDivValue, xAddValue, yAddValue);
 			singleStageAsString.clear();
 		}
@@ -43,7 +43,7 @@ PuzzleAnswerPair PuzzleSolvers::AocDayTwentyFourSolver(std::ifstream& puzzleInpu
 			singleStageAsString.append(inputLine + "\n");
 		}
 	}
-	Parsing::ParseStringIntoElements(singleStageAsString, matchString, zDivValue, xAddValue, yAddValue);
+	Parsing::ParseValidFormattedString<ALU::stageFormat>(singleStageAsString, zDivValue, xAddValue, yAddValue);
 	aluStages.emplace_back(zDivValue, xAddValue, yAddValue);
 	singleStageAsString.clear();
 
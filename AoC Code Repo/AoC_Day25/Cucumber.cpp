@@ -1,30 +1,37 @@
 #include "Cucumber.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
-// Constructor for the Trench. First initialise a GridUtils::Grid based on the 2D vector
-// of characters representing the initial state of the trench. Then scan the grid to find
-// the coordinates of cucumbers that will be unblocked on step 1.
-Cucumber::Trench::Trench(std::vector<std::vector<char>> gridIn) : cucumberGrid { gridIn }
+namespace
 {
-	for (GridUtils::Grid<char>::GridCell const &cell : cucumberGrid)
+	// Whether any cell of a row of a BitGrid is set.
+	bool AnySet(std::span<std::uint64_t const> row)
 	{
-		// Because East-moving cucumbers move first each step, the only requirement for an
-		// East-moving cucumber to be unblocked is that the space in front of it is empty.
-		// But for a South-facing cucumber to be unblocked, we also need to check that an
-		// East-cucumber will not move into that space before it gets a chance to move.
-		if ((cell.value == EAST_CUCUMBER) &&
-			(cell.RightOrWrap().value == EMPTY_SPACE))
-		{
-			unblockedEastCucumbers.push_back(cell.GetCoordinate());
-		}
-		else if ((cell.value == SOUTH_CUCUMBER) &&
-			(cell.DownOrWrap().value == EMPTY_SPACE) &&
-			(cell.DownOrWrap().LeftOrWrap().value != EAST_CUCUMBER))
+		return std::any_of(row.begin(), row.end(), [](std::uint64_t word) { return word != 0; });
+	}
+}
+
+// Constructor for the Trench. Both herds start out with every cucumber marked in the grid
+// for the current step, and the other grids are made the same size up front.
+Cucumber::Trench::Trench(std::vector<std::string> const& trenchLines)
+{
+	unsigned int width = trenchLines.front().size();
+	unsigned int height = trenchLines.size();
+	GridUtils::BitGrid eastCucumbers{ width, height };
+	GridUtils::BitGrid southCucumbers{ width, height };
+	for (unsigned int y = 0; y < height; y++)
+	{
+		assert(trenchLines[y].size() == width);
+		for (unsigned int x = 0; x < width; x++)
 		{
-			unblockedSouthCucumbers.push_back(cell.GetCoordinate());
+			if (trenchLines[y][x] == EAST_CUCUMBER) { eastCucumbers.Set({ x, y }, 1); }
+			else if (trenchLines[y][x] == SOUTH_CUCUMBER) { southCucumbers.Set({ x, y }, 1); }
 		}
 	}
+	eastHerd = GridUtils::DoubleBufferedGrid<GridUtils::BitGrid>{ eastCucumbers };
+	southHerd = GridUtils::DoubleBufferedGrid<GridUtils::BitGrid>{ southCucumbers };
+	workingCells = GridUtils::BitGrid{ width, height };
 }
 
 // Carry out movement steps until all cucumbers are unable to move. The final step number
@@ -36,115 +43,97 @@ unsigned int Cucumber::Trench::StepsUntilAllBlocked()
 	// function from a previous query (in which case it will be non-zero).
 	if (stepsUntilAllBlocked == 0)
 	{
-		while ((unblockedEastCucumbers.size() > 0) || (unblockedSouthCucumbers.size() > 0))
+		bool anyMoved{ true };
+		while (anyMoved)
 		{
-			CarryOutSingleMovementStep();
+			// East-moving cucumbers move first, and the South-moving cucumbers then move
+			// around wherever they ended up.
+			anyMoved = MoveEastHerd();
+			anyMoved = MoveSouthHerd() || anyMoved;
 			stepsUntilAllBlocked++;
 		}
-		stepsUntilAllBlocked++;
 	}
 	return stepsUntilAllBlocked;
 }
 
-// Carry out a single movement step.
-// The trench should already have a list of the coordinates of currently unblocked
-// East- and South-moving cucumbers which we can work through rather than actually
-// iterating over the grid. With each cucumber that moves though we need to both check
-// if it will still be able to move next step, and whether it's own movement frees up
-// any other cucumbers to move, and update the lists of unblocked cucumbers accordingly.
-void Cucumber::Trench::CarryOutSingleMovementStep()
+// Move every East-moving cucumber that has an empty space to the East of it, wrapping
+// around from the end of each row to the start. Each row is worked out separately:
+//  - The cells that block a cucumber are the occupied cells, rotated West by one cell, so
+//    each cucumber lines up with the cell in front of it.
+//  - The cucumbers that stay put are those that are blocked, and the rest move, which is
+//    just rotating them East by one cell.
+// Returns whether any cucumber moved.
+bool Cucumber::Trench::MoveEastHerd()
 {
-	// To avoid editing a list that we're actively iterating over, we will create new lists
-	// for each direction as we go, and then replace the lists wholesale afterwards.
-	std::list<GridUtils::Coordinate> newUnblockedEastCucumbers{};
-	std::list<GridUtils::Coordinate> newUnblockedSouthCucumbers{};
-
-	// East-moving cucumbers move first, so work through all of our East-moving cucumbers
-	// before the South-moving ones.
-	for (GridUtils::Coordinate eastCucumberOriginalPos : unblockedEastCucumbers)
+	GridUtils::BitGrid const& eastCucumbers = eastHerd.Current();
+	GridUtils::BitGrid const& southCucumbers = southHerd.Current();
+	GridUtils::BitGrid& movedEastCucumbers = eastHerd.Next();
+	bool anyMoved{ false };
+	for (unsigned int y = 0; y < eastCucumbers.Height(); y++)
 	{
-		// 'Move' our cucumber by resetting it's old position to be an empty space, and putting
-		// an East Cucumber character in its new location.
-		GridUtils::Coordinate eastCucumberNewPos = cucumberGrid[eastCucumberOriginalPos].RightOrWrap().GetCoordinate();
-		assert(cucumberGrid[eastCucumberNewPos].value == EMPTY_SPACE);
-		cucumberGrid[eastCucumberOriginalPos].value = EMPTY_SPACE;
-		cucumberGrid[eastCucumberNewPos].value = EAST_CUCUMBER;
+		workingCells.CopyRow(y, eastCucumbers.Row(y));
+		workingCells.OrRow(y, southCucumbers.Row(y));
+		workingCells.RotateRow(y, -1);
 
-		// If there is now room for another cucumber to move into the space that this one just
-		// vacated, update our lists accordingly. If there are two cucumbers able to move into
-		// that space, the South-moving one gets dibs, since South-moving cucumbers are yet
-		// to move this step.
-		if (cucumberGrid[eastCucumberOriginalPos].UpOrWrap().value == SOUTH_CUCUMBER)
-		{
-			unblockedSouthCucumbers.push_back(cucumberGrid[eastCucumberOriginalPos].UpOrWrap().GetCoordinate());
-		}
-		else if (cucumberGrid[eastCucumberOriginalPos].LeftOrWrap().value == EAST_CUCUMBER)
-		{
-			newUnblockedEastCucumbers.push_back(cucumberGrid[eastCucumberOriginalPos].LeftOrWrap().GetCoordinate());
-		}
+		movedEastCucumbers.CopyRow(y, eastCucumbers.Row(y));
+		movedEastCucumbers.AndRow(y, workingCells.Row(y));
+		workingCells.CopyRow(y, eastCucumbers.Row(y));
+		workingCells.XorRow(y, movedEastCucumbers.Row(y));
+		anyMoved = anyMoved || AnySet(workingCells.Row(y));
 
-		// If there is also a space in front of this cucumber's new position, and a South-moving
-		// cucumber is not about to move into it, place this cucumber on the new list of
-		// unblocked East-moving cucumbers ready for the next step.
-		GridUtils::Coordinate nextPotentialCoordinate = cucumberGrid[eastCucumberNewPos].RightOrWrap().GetCoordinate();
-		if ((cucumberGrid[nextPotentialCoordinate].value == EMPTY_SPACE) &&
-		    (cucumberGrid[nextPotentialCoordinate].UpOrWrap().value != SOUTH_CUCUMBER))
-		{
-			newUnblockedEastCucumbers.push_back(eastCucumberNewPos);
-		}
+		workingCells.RotateRow(y, 1);
+		movedEastCucumbers.OrRow(y, workingCells.Row(y));
 	}
-	unblockedEastCucumbers = newUnblockedEastCucumbers;
+	eastHerd.Swap();
+	return anyMoved;
+}
 
-	// East-moving cucumbers are now all done, with the list of unblocked South-moving cucumbers
-	// updated to reflect any South-moving cucumbers that can now move. So proceed with the
-	// South-moving cucumbers' half of this movement step.
-	for (GridUtils::Coordinate southCucumberOriginalPos : unblockedSouthCucumbers)
+// Move every South-moving cucumber that has an empty space to the South of it, wrapping
+// around from the bottom row to the top. This works in the same way as for the East-moving
+// cucumbers, except that lining up a cucumber with the cell in front of it, or moving it,
+// is a matter of picking which row to use rather than rotating a row.
+// Returns whether any cucumber moved.
+bool Cucumber::Trench::MoveSouthHerd()
+{
+	GridUtils::BitGrid const& eastCucumbers = eastHerd.Current();
+	GridUtils::BitGrid const& southCucumbers = southHerd.Current();
+	GridUtils::BitGrid& movedSouthCucumbers = southHerd.Next();
+	unsigned int const height = southCucumbers.Height();
+	bool anyMoved{ false };
+	for (unsigned int y = 0; y < height; y++)
 	{
-		// 'Move' our cucumber by resetting it's old position to be an empty space, and putting
-		// a South Cucumber character in its new location.
-		GridUtils::Coordinate southCucumberNewPos = cucumberGrid[southCucumberOriginalPos].DownOrWrap().GetCoordinate();
-		assert(cucumberGrid[southCucumberNewPos].value == EMPTY_SPACE);
-		cucumberGrid[southCucumberOriginalPos].value = EMPTY_SPACE;
-		cucumberGrid[southCucumberNewPos].value = SOUTH_CUCUMBER;
+		unsigned int rowInFront = (y + 1) % height;
+		workingCells.CopyRow(y, eastCucumbers.Row(rowInFront));
+		workingCells.OrRow(y, southCucumbers.Row(rowInFront));
 
-		// If there is now room for another cucumber to move into the space that this one just
-		// vacated, update our lists accordingly. If there are two cucumbers able to move into
-		// that space, the East-moving one gets dibs, since East-moving cucumbers will move first
-		// next step.
-		if (cucumberGrid[southCucumberOriginalPos].LeftOrWrap().value == EAST_CUCUMBER)
-		{
-			unblockedEastCucumbers.push_back(cucumberGrid[southCucumberOriginalPos].LeftOrWrap().GetCoordinate());
-		}
-		else if (cucumberGrid[southCucumberOriginalPos].UpOrWrap().value == SOUTH_CUCUMBER)
-		{
-			newUnblockedSouthCucumbers.push_back(cucumberGrid[southCucumberOriginalPos].UpOrWrap().GetCoordinate());
-		}
-
-		// If there is also a space in front of this cucumber's new position, and a East-moving
-		// cucumber is not about to move into it, place this cucumber on the new list of
-		// unblocked South-moving cucumbers ready for the next step.
-		GridUtils::Coordinate nextPotentialCoordinate = cucumberGrid[southCucumberNewPos].DownOrWrap().GetCoordinate();
-		if ((cucumberGrid[nextPotentialCoordinate].value == EMPTY_SPACE) &&
-			(cucumberGrid[nextPotentialCoordinate].LeftOrWrap().value != EAST_CUCUMBER))
-		{
-			newUnblockedSouthCucumbers.push_back(southCucumberNewPos);
-		}
+		movedSouthCucumbers.CopyRow(y, southCucumbers.Row(y));
+		movedSouthCucumbers.AndRow(y, workingCells.Row(y));
+		workingCells.CopyRow(y, southCucumbers.Row(y));
+		workingCells.XorRow(y, movedSouthCucumbers.Row(y));
+		anyMoved = anyMoved || AnySet(workingCells.Row(y));
 	}
-	unblockedSouthCucumbers = newUnblockedSouthCucumbers;
+	for (unsigned int y = 0; y < height; y++)
+	{
+		movedSouthCucumbers.OrRow((y + 1) % height, workingCells.Row(y));
+	}
+	southHerd.Swap();
+	return anyMoved;
 }
 
 // Diagnostic helper function to print out the current state of the trench.
 void Cucumber::Trench::PrintTrenchToScreen()
 {
+	GridUtils::BitGrid const& eastCucumbers = eastHerd.Current();
+	GridUtils::BitGrid const& southCucumbers = southHerd.Current();
 	std::cout << '\n';
-	for (unsigned int yy = cucumberGrid.Height() - 1; ; yy--)
+	for (unsigned int yy = 0; yy < eastCucumbers.Height(); yy++)
 	{
-		for (unsigned int xx = 0; xx < cucumberGrid.Width(); xx++)
+		for (unsigned int xx = 0; xx < eastCucumbers.Width(); xx++)
 		{
-			std::cout << cucumberGrid[{xx, yy}].value;
+			std::cout << (eastCucumbers.Get({ xx, yy }) ? EAST_CUCUMBER :
+				(southCucumbers.Get({ xx, yy }) ? SOUTH_CUCUMBER : EMPTY_SPACE));
 		}
-		if (yy == 0) { break; }
 		std::cout << '\n';
 	}
 	std::cout << std::endl;
-}
\ No newline at end of file
+}
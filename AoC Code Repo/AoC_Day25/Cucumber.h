@@ -1,6 +1,7 @@
 #pragma once
 #include "grid_utils.h"
-#include <list>
+#include <string>
+#include <vector>
 
 namespace Cucumber
 {
@@ -8,25 +9,29 @@ namespace Cucumber
 	constexpr char SOUTH_CUCUMBER = 'v';
 	constexpr char EMPTY_SPACE = '.';
 
-	// The Trench is initialised with a 2D array of characters where each cell is either
+	// The Trench is initialised with the lines of a grid where each cell is either
 	// empty ('.'), or contains an East moving ('>') or South moving ('v') cucumber.
 	// It can be queried to find how many time steps it takes before all of the cucumbers
 	// are blocked from further movement.
 	class Trench
 	{
 	private:
-		// The trench is represented as a Grid of characters. But to avoid iterating over the whole
-		// grid each step, all we actually need to keep track of is the coordinates of each currently
-		// unblocked cucumber.
-		GridUtils::Grid<char> cucumberGrid;
-		std::list<GridUtils::Coordinate> unblockedEastCucumbers;
-		std::list<GridUtils::Coordinate> unblockedSouthCucumbers;
+		// Each herd of cucumbers is held as a grid of bits, set where there's a cucumber of
+		// that herd, with rows in the same order as the input so that South is increasing y.
+		// Every cucumber in a herd moves at once, so a whole row of a herd can be moved a word
+		// at a time, from the grid for one step into the grid for the next. The grids for each
+		// step are double buffered, along with a spare grid for working out which cucumbers
+		// are blocked, so stepping never allocates.
+		GridUtils::DoubleBufferedGrid<GridUtils::BitGrid> eastHerd;
+		GridUtils::DoubleBufferedGrid<GridUtils::BitGrid> southHerd;
+		GridUtils::BitGrid workingCells;
 
 		unsigned int stepsUntilAllBlocked{ 0 };
-		void CarryOutSingleMovementStep();
+		bool MoveEastHerd();
+		bool MoveSouthHerd();
 		void PrintTrenchToScreen();
 	public:
-		Trench(std::vector<std::vector<char>> gridIn);
+		Trench(std::vector<std::string> const& trenchLines);
 		unsigned int StepsUntilAllBlocked();
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+#include "input_generators.h"
+#include "input_retrieval.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// A separate executable for generating large synthetic puzzle inputs, so that we can see
+// how the solvers scale. Inputs are written with the same file names as the real ones, so
+// the output directory can be handed straight to the solver with --input-dir.
+//
+// Usage: AoC_InputGenerator [--seed N] [--size N] [--output-dir DIR] [day...]
+// If no days are given, an input is generated for every day that has a generator. If no
+// size is given, each day uses its own default size, which is well beyond the real input.
+
+namespace
+{
+	constexpr const char defaultOutputDirectory[] = "Generated_Inputs";
+
+	struct GeneratorSettings
+	{
+		ULLINT seed{ 2021 };
+		unsigned int size{ 0 };
+		std::filesystem::path outputDirectory{ defaultOutputDirectory };
+		std::vector<unsigned int> days{};
+	};
+
+	InputGenerators::GeneratorDetails const* FindGenerator(unsigned int day)
+	{
+		for (InputGenerators::GeneratorDetails const& details : InputGenerators::generators)
+		{
+			if (details.day == day) { return &details; }
+		}
+		return nullptr;
+	}
+
+	// Parse the command line into the generator settings. Returns false if the command
+	// line doesn't make sense, in which case usage should be printed.
+	bool ParseArguments(int argc, char* argv[], GeneratorSettings& settings)
+	{
+		for (int argIndex = 1; argIndex < argc; argIndex++)
+		{
+			std::string argument{ argv[argIndex] };
+			bool hasValue = (argIndex + 1) < argc;
+			if ((argument == "--seed") && hasValue)
+			{
+				settings.seed = std::strtoull(argv[++argIndex], nullptr, 10);
+			}
+			else if ((argument == "--size") && hasValue)
+			{
+				settings.size = std::atoi(argv[++argIndex]);
+				if (settings.size == 0) { return false; }
+			}
+			else if ((argument == "--output-dir") && hasValue)
+			{
+				settings.outputDirectory = argv[++argIndex];
+			}
+			else
+			{
+				int day = std::atoi(argument.c_str());
+				if ((day <= 0) || (FindGenerator(day) == nullptr)) { return false; }
+				settings.days.push_back(day);
+			}
+		}
+
+		if (settings.days.empty())
+		{
+			for (InputGenerators::GeneratorDetails const& details : InputGenerators::generators)
+			{
+				settings.days.push_back(details.day);
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	GeneratorSettings settings{};
+	if (!ParseArguments(argc, argv, settings))
+	{
+		std::cout << "Usage: AoC_InputGenerator [--seed N] [--size N] [--output-dir DIR] [day...]" << std::endl;
+		std::cout << "Days with a generator:";
+		for (InputGenerators::GeneratorDetails const& details : InputGenerators::generators)
+		{
+			std::cout << " " << details.day;
+		}
+		std::cout << std::endl;
+		return 1;
+	}
+
+	std::filesystem::create_directories(settings.outputDirectory);
+	for (unsigned int day : settings.days)
+	{
+		InputGenerators::GeneratorDetails const* details = FindGenerator(day);
+		unsigned int size = (settings.size > 0) ? settings.size : details->defaultSize;
+
+		std::string dayString = std::to_string(day);
+		if (dayString.length() == 1) { dayString.insert(0, 1, '0'); }
+		std::filesystem::path outputFile = settings.outputDirectory /
+			(std::string{ InputRetrieval::puzzleInputFileStem } + dayString + InputRetrieval::puzzleInputFileExtension);
+
+		// Each day gets its own generator seeded from the overall seed, so that a day's input
+		// doesn't change depending on which other days were generated alongside it.
+		InputGenerators::SeededRandom random{ settings.seed * 100 + day };
+		std::ofstream output{ outputFile, std::ios::binary };
+		details->generator(output, size, random);
+
+		std::cout << "Day " << day << ": " << size << " " << details->sizeDescription <<
+			" written to " << outputFile.string() << std::endl;
+	}
+
+	return 0;
+}
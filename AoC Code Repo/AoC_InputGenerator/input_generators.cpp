@@ -0,0 +1,816 @@
+#include "input_generators.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	using Position = std::array<LLINT, 3>;
+
+	// Every line of an input is followed by a newline, apart from the last.
+	void StartLine(std::ostream& output, unsigned int lineIndex)
+	{
+		if (lineIndex > 0) { output << '\n'; }
+	}
+
+	// Put the elements of a container into a random order.
+	template <typename Container>
+	void Shuffle(Container& elements, InputGenerators::SeededRandom& random)
+	{
+		for (std::size_t ii = elements.size(); ii > 1; ii--)
+		{
+			std::swap(elements[ii - 1], elements[random.Between(0, static_cast<LLINT>(ii) - 1)]);
+		}
+	}
+
+	// The 24 orientations a day 19 scanner could be facing in, as rotation matrices.
+	// These are all of the matrices which map each axis onto a different axis (in either
+	// direction), excluding those which would mirror space rather than just rotating it.
+	std::vector<std::array<Position, 3>> ScannerRotations()
+	{
+		std::vector<std::array<Position, 3>> rotations{};
+		std::array<unsigned int, 3> axes{ 0, 1, 2 };
+		do
+		{
+			for (unsigned int signs = 0; signs < 8; signs++)
+			{
+				std::array<Position, 3> rotation{};
+				for (unsigned int row = 0; row < 3; row++)
+				{
+					rotation[row][axes[row]] = ((signs >> row) & 1) ? -1 : 1;
+				}
+
+				LLINT determinant =
+					rotation[0][0] * (rotation[1][1] * rotation[2][2] - rotation[1][2] * rotation[2][1]) -
+					rotation[0][1] * (rotation[1][0] * rotation[2][2] - rotation[1][2] * rotation[2][0]) +
+					rotation[0][2] * (rotation[1][0] * rotation[2][1] - rotation[1][1] * rotation[2][0]);
+				if (determinant == 1) { rotations.push_back(rotation); }
+			}
+		} while (std::next_permutation(axes.begin(), axes.end()));
+		return rotations;
+	}
+
+	// Writes a random run of day 10 brackets, opening a new chunk or closing the innermost
+	// open one at each step, and keeping track of which chunks are still open. Chunks are
+	// never nested more than maxDepth deep, so that completion costs (which multiply by 5
+	// for each bracket still open) stay well within 64 bits.
+	void WriteBracketChunks(
+		std::ostream& output,
+		unsigned int length,
+		std::string& openBrackets,
+		InputGenerators::SeededRandom& random)
+	{
+		constexpr std::size_t maxDepth = 20;
+		constexpr char openChars[] = "([{<";
+		constexpr char closeChars[] = ")]}>";
+		for (unsigned int ii = 0; ii < length; ii++)
+		{
+			bool openChunk = openBrackets.empty() ||
+				((openBrackets.size() < maxDepth) && (random.Between(0, 1) == 0));
+			if (openChunk)
+			{
+				openBrackets.push_back(openChars[random.Between(0, 3)]);
+				output << openBrackets.back();
+			}
+			else
+			{
+				std::size_t bracketIndex = std::string_view{ openChars }.find(openBrackets.back());
+				output << closeChars[bracketIndex];
+				openBrackets.pop_back();
+			}
+		}
+	}
+
+	// Day 16 packets are built up as a string of binary digits, which is only turned into
+	// hex once the whole transmission is complete.
+	void AppendBits(std::string& bits, ULLINT value, unsigned int numberOfBits)
+	{
+		for (unsigned int bit = numberOfBits; bit > 0; bit--)
+		{
+			bits += ((value >> (bit - 1)) & 1) ? '1' : '0';
+		}
+	}
+
+	// A literal packet holds its value in groups of 4 bits, each group prefixed by a 1 bit
+	// apart from the last, which is prefixed by a 0 bit.
+	void AppendLiteralPacket(std::string& bits, ULLINT value, InputGenerators::SeededRandom& random)
+	{
+		constexpr ULLINT literalTypeID = 4;
+		AppendBits(bits, random.Between(0, 7), 3);
+		AppendBits(bits, literalTypeID, 3);
+		unsigned int numberOfGroups{ 1 };
+		while ((numberOfGroups < 16) && ((value >> (4 * numberOfGroups)) != 0)) { numberOfGroups++; }
+		for (unsigned int group = numberOfGroups; group > 0; group--)
+		{
+			AppendBits(bits, (group > 1) ? 1 : 0, 1);
+			AppendBits(bits, value >> (4 * (group - 1)), 4);
+		}
+	}
+
+	// Appends a packet that holds numberOfPackets packets in all, counting itself and every
+	// packet nested within it. Products and comparisons only ever act on a few small literals,
+	// so that the value of the whole transmission stays well within 64 bits, while sums,
+	// minimums and maximums can hold any packets at all. An operator packet gives either the
+	// length in bits of the packets it holds, or how many of them there are, and we pick one
+	// at random where the length fits.
+	void AppendPacket(std::string& bits, unsigned int numberOfPackets, InputGenerators::SeededRandom& random)
+	{
+		constexpr ULLINT productTypeID = 1;
+		constexpr unsigned int maxLengthInBits = (1 << 15) - 1;
+		if (numberOfPackets == 1)
+		{
+			AppendLiteralPacket(bits, random.Between(0, 1000000), random);
+			return;
+		}
+
+		std::string subPacketBits{};
+		unsigned int numberOfSubPackets = numberOfPackets - 1;
+		ULLINT typeID{ 0 };
+		if ((numberOfPackets == 3) && (random.Between(0, 1) == 0))
+		{
+			typeID = random.Between(5, 7);
+			AppendLiteralPacket(subPacketBits, random.Between(0, 15), random);
+			AppendLiteralPacket(subPacketBits, random.Between(0, 15), random);
+		}
+		else if (numberOfPackets <= 4)
+		{
+			typeID = productTypeID;
+			for (unsigned int ii = 0; ii < numberOfSubPackets; ii++)
+			{
+				AppendLiteralPacket(subPacketBits, random.Between(1, 15), random);
+			}
+		}
+		else
+		{
+			// Share the packets out between a handful of sub-packets, giving each at least one.
+			typeID = std::array<ULLINT, 3>{ 0, 2, 3 }[random.Between(0, 2)];
+			unsigned int packetsLeft = numberOfPackets - 1;
+			numberOfSubPackets = static_cast<unsigned int>(random.Between(2, std::min<LLINT>(packetsLeft, 8)));
+			for (unsigned int ii = 0; ii < numberOfSubPackets; ii++)
+			{
+				unsigned int subPacketsLeft = numberOfSubPackets - ii;
+				unsigned int packetsInSubPacket = (subPacketsLeft == 1) ? packetsLeft :
+					static_cast<unsigned int>(random.Between(1, packetsLeft - (subPacketsLeft - 1)));
+				AppendPacket(subPacketBits, packetsInSubPacket, random);
+				packetsLeft -= packetsInSubPacket;
+			}
+		}
+
+		AppendBits(bits, random.Between(0, 7), 3);
+		AppendBits(bits, typeID, 3);
+		if ((subPacketBits.size() <= maxLengthInBits) && (random.Between(0, 1) == 0))
+		{
+			AppendBits(bits, 0, 1);
+			AppendBits(bits, subPacketBits.size(), 15);
+		}
+		else
+		{
+			AppendBits(bits, 1, 1);
+			AppendBits(bits, numberOfSubPackets, 11);
+		}
+		bits += subPacketBits;
+	}
+
+	// Writes a day 18 snailfish number that's already reduced, so has no pair nested inside
+	// four others and no regular number above 9.
+	void WriteSnailfishNumber(std::ostream& output, unsigned int depth, InputGenerators::SeededRandom& random)
+	{
+		constexpr unsigned int maxDepth = 4;
+		output << '[';
+		for (unsigned int element = 0; element < 2; element++)
+		{
+			if (element > 0) { output << ','; }
+			if ((depth < maxDepth) && (random.Between(0, 2) > 0))
+			{
+				WriteSnailfishNumber(output, depth + 1, random);
+			}
+			else
+			{
+				output << random.Between(0, 9);
+			}
+		}
+		output << ']';
+	}
+
+	bool WithinRange(Position const& first, Position const& second, LLINT range)
+	{
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			if (std::abs(first[axis] - second[axis]) > range) { return false; }
+		}
+		return true;
+	}
+
+	// Writes a cuboid step such as "on x=-20..26,y=-36..17,z=-47..7", with each range
+	// starting somewhere between lowest and highest and being up to maxLength long.
+	void WriteReactorStep(
+		std::ostream& output,
+		bool turnOn,
+		LLINT lowest,
+		LLINT highest,
+		LLINT maxLength,
+		InputGenerators::SeededRandom& random)
+	{
+		output << (turnOn ? "on" : "off");
+		char const* axisNames[] = { " x=", ",y=", ",z=" };
+		for (char const* axisName : axisNames)
+		{
+			LLINT rangeStart = random.Between(lowest, highest - 1);
+			LLINT rangeEnd = std::min(highest, rangeStart + random.Between(1, maxLength));
+			output << axisName << rangeStart << ".." << rangeEnd;
+		}
+	}
+}
+
+ULLINT InputGenerators::SeededRandom::Next()
+{
+	state += 0x9E3779B97F4A7C15ULL;
+	ULLINT mixed = state;
+	mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+	return mixed ^ (mixed >> 31);
+}
+
+LLINT InputGenerators::SeededRandom::Between(LLINT lowest, LLINT highest)
+{
+	ULLINT rangeSize = static_cast<ULLINT>(highest - lowest) + 1;
+	return lowest + static_cast<LLINT>(Next() % rangeSize);
+}
+
+// Day 1: one depth per line, mostly getting deeper but with the odd step back up.
+void InputGenerators::GenerateDayOneInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	LLINT depth = random.Between(100, 200);
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		output << depth;
+		depth = std::max<LLINT>(1, depth + random.Between(-10, 30));
+	}
+}
+
+// Day 2: one movement command per line, such as "forward 5", with magnitudes from 1 to 9.
+// As in the real input, the submarine is never aimed upwards, so 'up' is only used when
+// there's enough downward aim to take it off again.
+void InputGenerators::GenerateDayTwoInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	LLINT aim{ 0 };
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		LLINT magnitude = random.Between(1, 9);
+		LLINT roll = random.Between(0, 3);
+		if (roll < 2)
+		{
+			output << "forward " << magnitude;
+		}
+		else if ((roll == 2) && (aim >= magnitude))
+		{
+			output << "up " << magnitude;
+			aim -= magnitude;
+		}
+		else
+		{
+			output << "down " << magnitude;
+			aim += magnitude;
+		}
+	}
+}
+
+// Day 3: one 12 bit binary number per line, with each bit equally likely to be set or not.
+// The solver counts how many times each possible value appears, so its work only grows
+// with the number of lines and not with the values themselves.
+void InputGenerators::GenerateDayThreeInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr unsigned int numberOfBits = 12;
+	std::string number(numberOfBits, '0');
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		for (char& bit : number)
+		{
+			bit = random.Between(0, 1) ? '1' : '0';
+		}
+		StartLine(output, ii);
+		output << number;
+	}
+}
+
+// Day 4: the numbers 0 to 99 called in a random order, and then 5x5 bingo grids each holding
+// 25 different numbers from 0 to 99. The solver expects a single grid to win first and a
+// single grid to win last, so any grid that would win on the same number as the first or
+// last winner so far is swapped for another.
+void InputGenerators::GenerateDayFourInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr unsigned int numberOfCalls = 100;
+	constexpr unsigned int gridSize = 5;
+	std::vector<unsigned int> numbersToCall(numberOfCalls);
+	std::iota(numbersToCall.begin(), numbersToCall.end(), 0);
+	Shuffle(numbersToCall, random);
+	std::vector<unsigned int> turnCalled(numberOfCalls);
+	for (unsigned int turn = 0; turn < numberOfCalls; turn++)
+	{
+		turnCalled[numbersToCall[turn]] = turn;
+		if (turn > 0) { output << ','; }
+		output << numbersToCall[turn];
+	}
+
+	std::vector<unsigned int> gridNumbers(numberOfCalls);
+	std::iota(gridNumbers.begin(), gridNumbers.end(), 0);
+	unsigned int firstWinningTurn{ UINT_MAX };
+	unsigned int lastWinningTurn{ 0 };
+	unsigned int gridsWritten{ 0 };
+	while (gridsWritten < size)
+	{
+		// Shuffling just the front of the numbers is enough to pick the grid's numbers.
+		for (unsigned int ii = 0; ii < (gridSize * gridSize); ii++)
+		{
+			std::swap(gridNumbers[ii], gridNumbers[random.Between(ii, numberOfCalls - 1)]);
+		}
+
+		// A grid wins on the turn that completes its first row or column, and a row or
+		// column is complete on the turn that the last of its numbers is called.
+		unsigned int winningTurn{ UINT_MAX };
+		for (unsigned int line = 0; line < gridSize; line++)
+		{
+			unsigned int rowCompleted{ 0 };
+			unsigned int columnCompleted{ 0 };
+			for (unsigned int position = 0; position < gridSize; position++)
+			{
+				rowCompleted = std::max(rowCompleted, turnCalled[gridNumbers[(line * gridSize) + position]]);
+				columnCompleted = std::max(columnCompleted, turnCalled[gridNumbers[(position * gridSize) + line]]);
+			}
+			winningTurn = std::min({ winningTurn, rowCompleted, columnCompleted });
+		}
+		if ((winningTurn == firstWinningTurn) || (winningTurn == lastWinningTurn)) { continue; }
+		firstWinningTurn = std::min(firstWinningTurn, winningTurn);
+		lastWinningTurn = std::max(lastWinningTurn, winningTurn);
+
+		output << '\n';
+		for (unsigned int row = 0; row < gridSize; row++)
+		{
+			output << '\n';
+			for (unsigned int column = 0; column < gridSize; column++)
+			{
+				if (column > 0) { output << ' '; }
+				output << std::setw(2) << gridNumbers[(row * gridSize) + column];
+			}
+		}
+		gridsWritten++;
+	}
+}
+
+// Day 5: lines of vents in the form "x1,y1 -> x2,y2", split fairly evenly between horizontal,
+// vertical and 45 degree diagonal lines, all on the same 1000x1000 area as the real input.
+void InputGenerators::GenerateDayFiveInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr LLINT areaSize = 1000;
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		LLINT xStart = random.Between(0, areaSize - 1);
+		LLINT yStart = random.Between(0, areaSize - 1);
+		LLINT xFinish = xStart;
+		LLINT yFinish = yStart;
+		switch (random.Between(0, 2))
+		{
+		case 0:
+			xFinish = random.Between(0, areaSize - 1);
+			break;
+		case 1:
+			yFinish = random.Between(0, areaSize - 1);
+			break;
+		default:
+		{
+			// Diagonals have to be kept within the area in both directions at once.
+			LLINT xDirection = random.Between(0, 1) ? 1 : -1;
+			LLINT yDirection = random.Between(0, 1) ? 1 : -1;
+			LLINT xRoom = (xDirection > 0) ? (areaSize - 1 - xStart) : xStart;
+			LLINT yRoom = (yDirection > 0) ? (areaSize - 1 - yStart) : yStart;
+			LLINT length = random.Between(0, std::min(xRoom, yRoom));
+			xFinish = xStart + xDirection * length;
+			yFinish = yStart + yDirection * length;
+			break;
+		}
+		}
+
+		StartLine(output, ii);
+		output << xStart << ',' << yStart << " -> " << xFinish << ',' << yFinish;
+	}
+}
+
+// Day 6: a single comma separated line of lantern fish timers, each between 1 and 5.
+void InputGenerators::GenerateDaySixInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		if (ii > 0) { output << ','; }
+		output << random.Between(1, 5);
+	}
+}
+
+// Day 7: a single comma separated line of crab submarine positions. The real inputs lean
+// towards the lower positions, so each position is the lower of two rolls from 0 to 1999.
+void InputGenerators::GenerateDaySevenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		if (ii > 0) { output << ','; }
+		output << std::min(random.Between(0, 1999), random.Between(0, 1999));
+	}
+}
+
+// Day 8: one display per line, made up of the ten digits in a random order, then a " | ",
+// then a four digit number. Each line has its own random wiring of the letters a to g to
+// the seven segments, and the letters within each digit are in a random order too.
+void InputGenerators::GenerateDayEightInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr std::string_view digitSegments[] = {
+		"abcefg", "cf", "acdeg", "acdfg", "bcdf", "abdfg", "abdefg", "acf", "abcdefg", "abcdfg" };
+	std::string wiring{ "abcdefg" };
+	std::array<unsigned int, 10> digits{};
+	std::iota(digits.begin(), digits.end(), 0);
+	auto writeDigit = [&](unsigned int digit)
+	{
+		std::string wires{};
+		for (char segment : digitSegments[digit]) { wires += wiring[segment - 'a']; }
+		Shuffle(wires, random);
+		output << wires;
+	};
+
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		Shuffle(wiring, random);
+		Shuffle(digits, random);
+		for (unsigned int digit : digits)
+		{
+			writeDigit(digit);
+			output << ' ';
+		}
+		output << '|';
+		for (unsigned int position = 0; position < 4; position++)
+		{
+			output << ' ';
+			writeDigit(static_cast<unsigned int>(random.Between(0, 9)));
+		}
+	}
+}
+
+// Day 9: a square height map of digits. The real inputs are made up of basins surrounded
+// by ridges of 9s, so half of the heights are 9s. Any fewer and the basins start joining
+// up into one giant basin across the whole map, which the real inputs never have.
+void InputGenerators::GenerateDayNineInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	std::string row(size, '0');
+	for (unsigned int rowIndex = 0; rowIndex < size; rowIndex++)
+	{
+		for (char& height : row)
+		{
+			LLINT roll = random.Between(0, 17);
+			height = static_cast<char>('0' + std::min<LLINT>(roll, 9));
+		}
+		StartLine(output, rowIndex);
+		output << row;
+	}
+}
+
+// Day 10: lines of around 100 brackets, every one of which is either corrupted (a close
+// bracket that doesn't match the innermost open chunk) or incomplete (chunks still open
+// at the end of the line), as in the real input. Part 2 takes the middle completion cost,
+// so the last line is chosen to leave an odd number of incomplete lines.
+void InputGenerators::GenerateDayTenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr char closeChars[] = ")]}>";
+	unsigned int incompleteLines{ 0 };
+	std::string openBrackets{};
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		openBrackets.clear();
+		unsigned int lineLength = static_cast<unsigned int>(random.Between(90, 110));
+
+		bool isLastLine = (ii + 1) == size;
+		bool makeIncomplete = isLastLine ? ((incompleteLines % 2) == 0) : (random.Between(0, 1) == 0);
+		if (makeIncomplete)
+		{
+			WriteBracketChunks(output, lineLength, openBrackets, random);
+			if (openBrackets.empty())
+			{
+				WriteBracketChunks(output, 1, openBrackets, random);
+			}
+			incompleteLines++;
+		}
+		else
+		{
+			// Corrupt the line part way along, with any close bracket other than the right
+			// one. There has to be an open chunk at that point for the close bracket to be
+			// wrong for, rather than just being unexpected.
+			unsigned int corruptionPoint = static_cast<unsigned int>(random.Between(1, lineLength - 1));
+			WriteBracketChunks(output, corruptionPoint, openBrackets, random);
+			if (openBrackets.empty())
+			{
+				WriteBracketChunks(output, 1, openBrackets, random);
+			}
+			std::size_t rightBracketIndex = std::string_view{ "([{<" }.find(openBrackets.back());
+			std::size_t wrongBracketIndex = (rightBracketIndex + random.Between(1, 3)) % 4;
+			output << closeChars[wrongBracketIndex];
+			WriteBracketChunks(output, lineLength - corruptionPoint, openBrackets, random);
+		}
+	}
+}
+
+// Day 13: dots on a sheet of paper, followed by the same folds as the real input, which
+// halve a sheet of 1311x895 down to 40x6. The dots are made by picking some of the
+// positions on the folded paper to show up, and then unfolding each dot from one of those
+// positions, crossing each fold line or not at random. Unfolding never puts a dot on a
+// fold line, as the puzzle promises. Each dot is only listed once, so there can't be more
+// dots than there are places for them, and size is capped at half of that.
+void InputGenerators::GenerateDayThirteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	struct Fold
+	{
+		char axis;
+		LLINT position;
+	};
+	constexpr Fold folds[] = {
+		{ 'x', 655 }, { 'y', 447 }, { 'x', 327 }, { 'y', 223 }, { 'x', 163 }, { 'y', 111 },
+		{ 'x', 81 }, { 'y', 55 }, { 'x', 40 }, { 'y', 27 }, { 'y', 13 }, { 'y', 6 } };
+	constexpr LLINT foldedWidth = 40;
+	constexpr LLINT foldedHeight = 6;
+
+	std::vector<std::array<LLINT, 2>> visiblePositions{};
+	for (LLINT y = 0; y < foldedHeight; y++)
+	{
+		for (LLINT x = 0; x < foldedWidth; x++)
+		{
+			if (random.Between(0, 1) == 0) { visiblePositions.push_back({ x, y }); }
+		}
+	}
+	std::size_t const placesForDots = visiblePositions.size() << std::size(folds);
+	unsigned int const numberOfDots = static_cast<unsigned int>(std::min<std::size_t>(size, placesForDots / 2));
+
+	std::unordered_set<ULLINT> dotsMade{};
+	unsigned int dotIndex{ 0 };
+	while (dotIndex < numberOfDots)
+	{
+		std::array<LLINT, 2> dot = visiblePositions[random.Between(0, static_cast<LLINT>(visiblePositions.size()) - 1)];
+		for (auto foldItr = std::rbegin(folds); foldItr != std::rend(folds); foldItr++)
+		{
+			LLINT& positionAcrossFold = dot[(foldItr->axis == 'x') ? 0 : 1];
+			if (random.Between(0, 1) == 0) { positionAcrossFold = (foldItr->position * 2) - positionAcrossFold; }
+		}
+		if (!dotsMade.insert((static_cast<ULLINT>(dot[0]) << 32) | static_cast<ULLINT>(dot[1])).second) { continue; }
+
+		StartLine(output, dotIndex);
+		output << dot[0] << ',' << dot[1];
+		dotIndex++;
+	}
+
+	output << '\n';
+	for (Fold const& fold : folds)
+	{
+		output << "\nfold along " << fold.axis << '=' << fold.position;
+	}
+}
+
+// Day 14: a polymer template of random elements, followed by an insertion rule for every
+// pair of the same 10 elements that the real input uses. The counts of each element after
+// 40 steps grow with the length of the template times 2^40, so templates of up to a few
+// million elements keep them within 64 bits.
+void InputGenerators::GenerateDayFourteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr std::string_view elements{ "BCFHKNOPSV" };
+	auto randomElement = [&]() { return elements[random.Between(0, static_cast<LLINT>(elements.size()) - 1)]; };
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		output << randomElement();
+	}
+
+	output << '\n';
+	for (char first : elements)
+	{
+		for (char second : elements)
+		{
+			output << '\n' << first << second << " -> " << randomElement();
+		}
+	}
+}
+
+// Day 15: a square grid of risk levels, each between 1 and 9.
+void InputGenerators::GenerateDayFifteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	std::string row(size, '1');
+	for (unsigned int rowIndex = 0; rowIndex < size; rowIndex++)
+	{
+		for (char& risk : row)
+		{
+			risk = static_cast<char>('0' + random.Between(1, 9));
+		}
+		StartLine(output, rowIndex);
+		output << row;
+	}
+}
+
+// Day 16: a single transmission in hex, made up of an operator packet holding size packets
+// in all, nested to whatever depth they happen to be. The transmission is padded with 0s
+// to a whole number of hex digits, as in the real input.
+void InputGenerators::GenerateDaySixteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	std::string bits{};
+	AppendPacket(bits, std::max(size, 2u), random);
+	bits.append((4 - (bits.size() % 4)) % 4, '0');
+
+	constexpr char hexDigits[] = "0123456789ABCDEF";
+	for (std::size_t nibble = 0; nibble < bits.size(); nibble += 4)
+	{
+		unsigned int hexValue = static_cast<unsigned int>(std::stoul(bits.substr(nibble, 4), nullptr, 2));
+		output << hexDigits[hexValue];
+	}
+}
+
+// Day 18: one reduced snailfish number per line. Part 2 adds up every pair of numbers, so
+// the work grows with the square of the number of lines.
+void InputGenerators::GenerateDayEighteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		WriteSnailfishNumber(output, 1, random);
+	}
+}
+
+// Day 19: scanners and the beacons they can see. For the puzzle to be solvable, every
+// scanner has to share at least 12 beacons with some other scanner, such that all of the
+// scanners end up connected. So each new scanner is placed near one we've already placed,
+// and beacons are added to the space they both cover until they share enough of them.
+// Every scanner then reports every beacon within 1000 on each axis, relative to itself
+// and rotated into one of the 24 orientations it could be facing.
+void InputGenerators::GenerateDayNineteenInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr LLINT scannerRange = 1000;
+	constexpr LLINT maxScannerSpacing = 1100;
+	constexpr unsigned int minSharedBeacons = 12;
+
+	std::vector<Position> scanners{ Position{ 0, 0, 0 } };
+	std::vector<Position> beacons{};
+	std::unordered_set<std::string> beaconSet{};
+	auto addBeacon = [&](Position const& beacon)
+	{
+		std::string beaconKey = std::to_string(beacon[0]) + ',' + std::to_string(beacon[1]) + ',' + std::to_string(beacon[2]);
+		if (beaconSet.insert(beaconKey).second)
+		{
+			beacons.push_back(beacon);
+		}
+	};
+	auto addBeaconsNear = [&](Position const& scanner, unsigned int numberOfBeacons)
+	{
+		for (unsigned int ii = 0; ii < numberOfBeacons; ii++)
+		{
+			addBeacon(Position{
+				scanner[0] + random.Between(-scannerRange, scannerRange),
+				scanner[1] + random.Between(-scannerRange, scannerRange),
+				scanner[2] + random.Between(-scannerRange, scannerRange) });
+		}
+	};
+	addBeaconsNear(scanners[0], static_cast<unsigned int>(random.Between(20, 30)));
+
+	while (scanners.size() < size)
+	{
+		Position const parent = scanners[random.Between(0, static_cast<LLINT>(scanners.size()) - 1)];
+		Position scanner{};
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			scanner[axis] = parent[axis] + random.Between(-maxScannerSpacing, maxScannerSpacing);
+		}
+
+		// Top up the beacons in the space covered by both scanners, then give the new scanner
+		// a few beacons of its own.
+		auto isShared = [&](Position const& beacon)
+		{
+			return WithinRange(beacon, parent, scannerRange) && WithinRange(beacon, scanner, scannerRange);
+		};
+		unsigned int sharedBeacons = static_cast<unsigned int>(std::count_if(beacons.begin(), beacons.end(), isShared));
+		while (sharedBeacons < minSharedBeacons)
+		{
+			Position beacon{};
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				LLINT lowest = std::max(parent[axis], scanner[axis]) - scannerRange;
+				LLINT highest = std::min(parent[axis], scanner[axis]) + scannerRange;
+				beacon[axis] = random.Between(lowest, highest);
+			}
+			std::size_t beaconsBefore = beacons.size();
+			addBeacon(beacon);
+			sharedBeacons += static_cast<unsigned int>(beacons.size() - beaconsBefore);
+		}
+		addBeaconsNear(scanner, static_cast<unsigned int>(random.Between(5, 10)));
+		scanners.push_back(scanner);
+	}
+
+	std::vector<std::array<Position, 3>> const rotations = ScannerRotations();
+	for (unsigned int scannerIndex = 0; scannerIndex < scanners.size(); scannerIndex++)
+	{
+		Position const& scanner = scanners[scannerIndex];
+		std::array<Position, 3> const& rotation = rotations[random.Between(0, static_cast<LLINT>(rotations.size()) - 1)];
+
+		std::vector<Position> visibleBeacons{};
+		for (Position const& beacon : beacons)
+		{
+			if (!WithinRange(beacon, scanner, scannerRange)) { continue; }
+			Position rotatedBeacon{};
+			for (unsigned int row = 0; row < 3; row++)
+			{
+				for (unsigned int axis = 0; axis < 3; axis++)
+				{
+					rotatedBeacon[row] += rotation[row][axis] * (beacon[axis] - scanner[axis]);
+				}
+			}
+			visibleBeacons.push_back(rotatedBeacon);
+		}
+
+		// Shuffle the reports so that overlapping scanners don't list their shared beacons
+		// in the same order.
+		Shuffle(visibleBeacons, random);
+
+		if (scannerIndex > 0) { output << "\n\n"; }
+		output << "--- scanner " << scannerIndex << " ---";
+		for (Position const& beacon : visibleBeacons)
+		{
+			output << '\n' << beacon[0] << ',' << beacon[1] << ',' << beacon[2];
+		}
+	}
+}
+
+// Day 20: the 512 character enhancement algorithm and then a square image. As in the real
+// input, the algorithm lights every dark cell surrounded by dark cells and darkens every
+// light cell surrounded by light cells, so the infinite region beyond the image flashes
+// on and off, and is dark again after every even number of rounds.
+void InputGenerators::GenerateDayTwentyInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr unsigned int algorithmLength = 512;
+	std::string algorithm(algorithmLength, '.');
+	for (char& cell : algorithm)
+	{
+		cell = random.Between(0, 1) ? '#' : '.';
+	}
+	algorithm.front() = '#';
+	algorithm.back() = '.';
+	output << algorithm << '\n';
+
+	std::string row(size, '.');
+	for (unsigned int rowIndex = 0; rowIndex < size; rowIndex++)
+	{
+		for (char& cell : row)
+		{
+			cell = random.Between(0, 1) ? '#' : '.';
+		}
+		output << '\n' << row;
+	}
+}
+
+// Day 22: reboot steps of the form "on x=-20..26,y=-36..17,z=-47..7". As in the real input,
+// the first 20 steps are small ones within the initialisation area (-50..50 on each axis),
+// starting with an 'on', and the rest are large ones spread over a much bigger volume.
+void InputGenerators::GenerateDayTwentyTwoInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	constexpr unsigned int initialisationSteps = 20;
+	for (unsigned int ii = 0; ii < size; ii++)
+	{
+		StartLine(output, ii);
+		bool turnOn = (ii == 0) || (random.Between(0, 2) > 0);
+		if (ii < initialisationSteps)
+		{
+			WriteReactorStep(output, turnOn, -50, 50, 50, random);
+		}
+		else
+		{
+			WriteReactorStep(output, turnOn, -100000, 100000, 30000, random);
+		}
+	}
+}
+
+// Day 25: a square sea floor with about a quarter of it east facing sea cucumbers, a quarter
+// south facing ones and the rest empty, as in the real input. At that density the herds
+// jam up within a few thousand steps even on a 2000x2000 sea floor, rather than any row or
+// column being left to cycle around forever.
+void InputGenerators::GenerateDayTwentyFiveInput(std::ostream& output, unsigned int size, SeededRandom& random)
+{
+	std::string row(size, '.');
+	for (unsigned int rowIndex = 0; rowIndex < size; rowIndex++)
+	{
+		for (char& cell : row)
+		{
+			LLINT roll = random.Between(0, 3);
+			cell = (roll == 0) ? '>' : ((roll == 1) ? 'v' : '.');
+		}
+		StartLine(output, rowIndex);
+		output << row;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include <ostream>
+#include "aoc_common_types.h"
+
+// Generators for synthetic puzzle inputs of whatever size we like, so that we can see how
+// the solvers scale beyond the fixed inputs in Puzzle_Inputs. Every generated input is
+// valid for its day's puzzle, and follows the same layout as the real inputs (including
+// having no newline after the final line).
+// Generation is driven entirely by the seed, so the same seed and size always produce
+// exactly the same input on every platform, and benchmark results can be reproduced.
+namespace InputGenerators
+{
+	// A small, fully specified pseudo-random number generator (SplitMix64). The standard
+	// library's distributions are free to differ between implementations, so we don't
+	// use them here.
+	class SeededRandom
+	{
+	public:
+		explicit SeededRandom(ULLINT seed) : state{ seed } {}
+
+		ULLINT Next();
+
+		// A value between lowest and highest inclusive. The tiny bias from taking a modulus
+		// doesn't matter for our purposes.
+		LLINT Between(LLINT lowest, LLINT highest);
+
+	private:
+		ULLINT state;
+	};
+
+	// Writes an input for a given day to the output stream. What 'size' controls depends on
+	// the day, e.g. the number of lines for day 5, or the width of the grid for day 15.
+	using InputGenerator = void(*)(std::ostream& output, unsigned int size, SeededRandom& random);
+
+	struct GeneratorDetails
+	{
+		unsigned int day;
+		InputGenerator generator;
+		unsigned int defaultSize;
+		char const* sizeDescription;
+	};
+
+	void GenerateDayOneInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayTwoInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayThreeInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayFourInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayFiveInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDaySixInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDaySevenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayEightInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayNineInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayTenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayThirteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayFourteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayFifteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDaySixteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayEighteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayNineteenInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayTwentyInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayTwentyTwoInput(std::ostream& output, unsigned int size, SeededRandom& random);
+	void GenerateDayTwentyFiveInput(std::ostream& output, unsigned int size, SeededRandom& random);
+
+	// The remaining days have no generator, since there's nothing in their input that can be
+	// made bigger without changing the puzzle:
+	//  - Day 11: the part 2 answer is the first step on which every octopus flashes at once,
+	//    which a grid other than the puzzle's own 10x10 ones may never reach, leaving the
+	//    solver stepping forever.
+	//  - Day 12: the number of paths through the caves grows exponentially with the number
+	//    of caves, so anything much bigger than the real input could never be solved.
+	//  - Day 17: the input is a single target area, and the solver's work depends on where
+	//    that area is rather than on any amount of input.
+	//  - Day 21: the input is just the two players' starting positions.
+	//  - Day 23: the burrow always has the same shape, with four rooms and a hallway.
+	//  - Day 24: the solver relies on the input being the puzzle's own 14 block program.
+	constexpr GeneratorDetails generators[] = {
+		{ 1, GenerateDayOneInput, 100000, "depth readings" },
+		{ 2, GenerateDayTwoInput, 100000, "movement commands" },
+		{ 3, GenerateDayThreeInput, 100000, "diagnostic numbers" },
+		{ 4, GenerateDayFourInput, 10000, "bingo grids" },
+		{ 5, GenerateDayFiveInput, 100000, "line segments" },
+		{ 6, GenerateDaySixInput, 100000, "lantern fish" },
+		{ 7, GenerateDaySevenInput, 100000, "crab submarines" },
+		{ 8, GenerateDayEightInput, 100000, "displays" },
+		{ 9, GenerateDayNineInput, 2000, "height map width and height" },
+		{ 10, GenerateDayTenInput, 10000, "lines of brackets" },
+		{ 13, GenerateDayThirteenInput, 100000, "dots" },
+		{ 14, GenerateDayFourteenInput, 100000, "polymer template elements" },
+		{ 15, GenerateDayFifteenInput, 1000, "risk grid width and height" },
+		{ 16, GenerateDaySixteenInput, 100000, "packets" },
+		{ 18, GenerateDayEighteenInput, 300, "snailfish numbers" },
+		{ 19, GenerateDayNineteenInput, 1000, "scanners" },
+		{ 20, GenerateDayTwentyInput, 500, "image width and height" },
+		{ 22, GenerateDayTwentyTwoInput, 10000, "reboot steps" },
+		{ 25, GenerateDayTwentyFiveInput, 1000, "sea floor width and height" }
+	};
+}
\ No newline at end of file